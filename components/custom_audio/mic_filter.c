@@ -0,0 +1,107 @@
+#include "mic_filter.h"
+#include <math.h>
+#include <string.h>
+
+// ------------------------
+// High-pass filter state
+// ------------------------
+typedef struct {
+    float a0, a1, b1;
+    float prev_input;
+    float prev_output;
+} hp_filter_t;
+
+static hp_filter_t hp;
+
+// ------------------------
+// Noise gate parameters
+// ------------------------
+#define NOISE_GATE_THRESHOLD  1000.0f  // Adjust based on your mic/noise level
+#define NOISE_GATE_HYSTERESIS 0.8f      // Prevent rapid on/off gating
+
+static int gate_open = 0;
+
+// ------------------------
+// Initialize high-pass filter
+// fc: cutoff frequency in Hz
+// fs: sampling rate in Hz
+// ------------------------
+static void hp_filter_init(hp_filter_t *filt, float fc, float fs) {
+    float c = tanf(M_PI * fc / fs);
+    float a0_inv = 1.0f / (1.0f + c);
+    filt->a0 = a0_inv;
+    filt->a1 = -a0_inv;
+    filt->b1 = (1.0f - c) * a0_inv;
+    filt->prev_input = 0;
+    filt->prev_output = 0;
+}
+
+// ------------------------
+// Apply high-pass filter
+// ------------------------
+static inline float hp_filter_apply(hp_filter_t *filt, float input) {
+    float output = filt->a0 * input + filt->a1 * filt->prev_input + filt->b1 * filt->prev_output;
+    filt->prev_input = input;
+    filt->prev_output = output;
+    return output;
+}
+
+void mic_filter_init(float fc, float fs) {
+    hp_filter_init(&hp, fc, fs);
+    gate_open = 0;
+}
+
+// ------------------------
+// Apply HPF + Noise Gate to one frame of 16-bit samples
+// Returns bytes kept in samples, or 0 if gated (silence)
+// ------------------------
+int mic_filter_process(int16_t *samples, int sample_count, i2s_mic_stats_t *stats) {
+    float peak = 0.0f;
+    float energy = 0.0f;
+
+    for (int i = 0; i < sample_count; i++) {
+        // Apply HPF
+        float y = hp_filter_apply(&hp, (float)samples[i]);
+        samples[i] = (int16_t)y;
+
+        energy += y * y;
+
+        // Track peak for noise gate decision
+        float abs_val = fabsf(y);
+        if (abs_val > peak) {
+            peak = abs_val;
+        }
+    }
+
+    if (stats) {
+        stats->peak = peak;
+        stats->rms = sample_count > 0 ? sqrtf(energy / sample_count) : 0.0f;
+        stats->rms_dbfs = 20.0f * log10f((stats->rms + 1.0f) / 32768.0f);
+        stats->frames++;
+    }
+
+    // Noise gate logic
+    int output_bytes = sample_count * sizeof(int16_t);
+    int gated = 0;
+    if (gate_open) {
+        if (peak < NOISE_GATE_THRESHOLD * NOISE_GATE_HYSTERESIS) {
+            gate_open = 0;
+            gated = 1;
+        }
+    } else {
+        if (peak > NOISE_GATE_THRESHOLD) {
+            gate_open = 1;
+        } else {
+            gated = 1;
+        }
+    }
+
+    if (stats) {
+        stats->gated = gated;
+    }
+    if (gated) {
+        memset(samples, 0, output_bytes);
+        return 0;
+    }
+    return output_bytes;
+}
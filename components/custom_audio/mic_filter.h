@@ -0,0 +1,23 @@
+#ifndef MIC_FILTER_H
+#define MIC_FILTER_H
+
+#include <stdint.h>
+
+// Level of one frame, measured after the HPF and before the noise gate
+typedef struct {
+    float peak;         // absolute peak, 16-bit sample units
+    float rms;          // RMS, 16-bit sample units
+    float rms_dbfs;     // RMS in dB relative to full scale
+    int gated;          // 1 if the noise gate silenced this frame
+    uint32_t frames;    // frames measured since boot
+} i2s_mic_stats_t;
+
+#define MIC_FILTER_HPF_CUTOFF_HZ  120.0f
+
+// Reset the HPF and close the gate. fc: HPF cutoff in Hz, fs: sampling rate in Hz
+void mic_filter_init(float fc, float fs);
+// Apply HPF + noise gate in place to one frame of 16-bit samples and update stats (optional).
+// Returns bytes kept, or 0 if gated (samples zeroed)
+int mic_filter_process(int16_t *samples, int sample_count, i2s_mic_stats_t *stats);
+
+#endif
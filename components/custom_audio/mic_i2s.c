@@ -1,62 +1,23 @@
 #include "mic_i2s.h"
 #include "driver/i2s_std.h"
 #include "esp_log.h"
-#include <math.h>
 #include <string.h>
 #include <portmacro.h>
 
 static const char *TAG = "MIC_I2S";
 i2s_chan_handle_t rx_chan; // RX channel handle
 
-// ------------------------
-// High-pass filter state
-// ------------------------
-typedef struct {
-    float a0, a1, b1;
-    float prev_input;
-    float prev_output;
-} hp_filter_t;
-
-static hp_filter_t hp;
-
-// ------------------------
-// Noise gate parameters
-// ------------------------
-#define NOISE_GATE_THRESHOLD  1000.0f  // Adjust based on your mic/noise level
-#define NOISE_GATE_HYSTERESIS 0.8f      // Prevent rapid on/off gating
-
-static int gate_open = 0;
-
-// ------------------------
-// Initialize high-pass filter
-// fc: cutoff frequency in Hz
-// fs: sampling rate in Hz
-// ------------------------
-static void hp_filter_init(hp_filter_t *filt, float fc, float fs) {
-    float c = tanf(M_PI * fc / fs);
-    float a0_inv = 1.0f / (1.0f + c);
-    filt->a0 = a0_inv;
-    filt->a1 = -a0_inv;
-    filt->b1 = (1.0f - c) * a0_inv;
-    filt->prev_input = 0;
-    filt->prev_output = 0;
-}
-
-// ------------------------
-// Apply high-pass filter
-// ------------------------
-static inline float hp_filter_apply(hp_filter_t *filt, float input) {
-    float output = filt->a0 * input + filt->a1 * filt->prev_input + filt->b1 * filt->prev_output;
-    filt->prev_input = input;
-    filt->prev_output = output;
-    return output;
-}
+// Level of the most recent frame, before gating
+static i2s_mic_stats_t last_stats;
 
 // ------------------------
 // I2S mic init
+// dma_desc_num / dma_frame_num: DMA ring geometry, see i2s_chan_config_t
 // ------------------------
-void i2s_mic_init(void) {
+static void i2s_mic_init_channel(uint32_t dma_desc_num, uint32_t dma_frame_num) {
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_1, I2S_ROLE_MASTER);
+    chan_cfg.dma_desc_num = dma_desc_num;
+    chan_cfg.dma_frame_num = dma_frame_num;
 
     ESP_ERROR_CHECK(i2s_new_channel(&chan_cfg, NULL, &rx_chan));
 
@@ -76,10 +37,32 @@ void i2s_mic_init(void) {
 
     ESP_ERROR_CHECK(i2s_channel_init_std_mode(rx_chan, &std_cfg));
     ESP_ERROR_CHECK(i2s_channel_enable(rx_chan));
-    ESP_LOGI(TAG, "I2S STD RX channel initialized @16kHz mono");
+    ESP_LOGI(TAG, "I2S STD RX channel initialized @16kHz mono (%lu x %lu frame DMA)",
+             (unsigned long)dma_desc_num, (unsigned long)dma_frame_num);
 
     // Init high-pass filter at 120 Hz cutoff
-    hp_filter_init(&hp, 120.0f, 16000.0f);
+    mic_filter_init(MIC_FILTER_HPF_CUTOFF_HZ, 16000.0f);
+}
+
+void i2s_mic_init(void) {
+    i2s_mic_init_channel(6, 240);
+}
+
+void i2s_mic_init_batched(int frame_samples, int batch_frames) {
+    // One descriptor per frame (32-bit slots, so at most 1023 samples per descriptor) and
+    // two spare descriptors so capture keeps running while a batch is being processed.
+    i2s_mic_init_channel(batch_frames + 2, frame_samples);
+}
+
+// ------------------------
+// Convert one frame of raw 32-bit samples to 16-bit and apply HPF + Noise Gate
+// Returns bytes written into samples, or 0 if gated (silence)
+// ------------------------
+static int i2s_mic_process(const int32_t *raw_buffer, int16_t *samples, int sample_count) {
+    for (int i = 0; i < sample_count; i++) {
+        samples[i] = (int16_t)(raw_buffer[i] >> 14);
+    }
+    return mic_filter_process(samples, sample_count, &last_stats);
 }
 
 // ------------------------
@@ -113,44 +96,50 @@ int i2s_mic_read(void *buf, int len) {
     }
 
     // Convert raw 32-bit samples to 16-bit and store in output buffer
-    int16_t *samples = (int16_t *)buf;
-    int sample_count = bytes_read / sizeof(int32_t);
-    
-    float peak = 0.0f;
+    int ret = i2s_mic_process(raw_buffer, (int16_t *)buf, bytes_read / sizeof(int32_t));
+    free(raw_buffer);
+    return ret;
+}
 
-    for (int i = 0; i < sample_count; i++) {
-        // Convert 32-bit to 16-bit
-        int16_t sample16 = (int16_t)(raw_buffer[i] >> 14);
-        
-        // Apply HPF
-        float y = hp_filter_apply(&hp, (float)sample16);
-        samples[i] = (int16_t)y;
-
-        // Track peak for noise gate decision
-        float abs_val = fabsf(y);
-        if (abs_val > peak) {
-            peak = abs_val;
-        }
+// ------------------------
+// Read nframes frames with a single blocking DMA read, then filter and gate each frame
+// on its own so the gate and the level statistics keep per-frame resolution.
+// ------------------------
+int i2s_mic_read_batch(int16_t *buf, int frame_samples, int nframes, i2s_mic_stats_t *stats) {
+    if (!rx_chan) {
+        ESP_LOGE(TAG, "I2S channel not initialized");
+        return -1;
     }
 
-    free(raw_buffer);
+    size_t raw_buffer_size = (size_t)frame_samples * nframes * sizeof(int32_t);
+    int32_t *raw_buffer = malloc(raw_buffer_size);
+    if (!raw_buffer) {
+        ESP_LOGE(TAG, "Failed to allocate raw buffer");
+        return -1;
+    }
 
-    // Noise gate logic
-    int output_bytes = sample_count * sizeof(int16_t);
-    if (gate_open) {
-        if (peak < NOISE_GATE_THRESHOLD * NOISE_GATE_HYSTERESIS) {
-            gate_open = 0;
-            memset(buf, 0, output_bytes);
-            return 0;
-        }
-    } else {
-        if (peak > NOISE_GATE_THRESHOLD) {
-            gate_open = 1;
-        } else {
-            memset(buf, 0, output_bytes);
-                return 0;
+    size_t bytes_read = 0;
+    esp_err_t err = i2s_channel_read(rx_chan, raw_buffer, raw_buffer_size, &bytes_read, portMAX_DELAY);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "i2s_channel_read error %d", err);
+        free(raw_buffer);
+        return -1;
+    }
+
+    int frames = bytes_read / (frame_samples * sizeof(int32_t));
+    for (int i = 0; i < frames; i++) {
+        i2s_mic_process(raw_buffer + i * frame_samples, buf + i * frame_samples, frame_samples);
+        if (stats) {
+            stats[i] = last_stats;
         }
     }
 
-    return output_bytes;
+    free(raw_buffer);
+    return frames;
+}
+
+void i2s_mic_get_stats(i2s_mic_stats_t *stats) {
+    if (stats) {
+        *stats = last_stats;
+    }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define MIC_I2S_H 
  
 #include <stdint.h>
+#include "mic_filter.h"
 
 #define FRAME_SAMPLES 480
 #define OUT_SAMPLES   160
@@ -12,7 +13,14 @@ extern int16_t out_buf[OUT_SAMPLES];
 
 
 void i2s_mic_init(void); 
+// DMA sized so one descriptor holds frame_samples and a batch of batch_frames fits in the ring
+void i2s_mic_init_batched(int frame_samples, int batch_frames);
 int i2s_mic_read(void* buffer, int len);
+// Read nframes frames in one blocking call; stats[i] (optional) receives each frame's level.
+// Returns the number of frames read, or -1 on error. Gated frames are zeroed in buf.
+int i2s_mic_read_batch(int16_t *buf, int frame_samples, int nframes, i2s_mic_stats_t *stats);
+// Level of the last frame returned by i2s_mic_read(), see i2s_mic_stats_t
+void i2s_mic_get_stats(i2s_mic_stats_t *stats);
 // void convert_32bit_to_16bit(int32_t *src, int16_t *dst, int sample_count); 
 // void fir_filter(float input, float *output); 
 // void downsample_48_to_16(int16_t *in_samples, int in_len, int16_t *out_samples, int *out_len); 
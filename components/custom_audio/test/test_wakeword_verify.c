@@ -0,0 +1,92 @@
+#include <string.h>
+#include "unity.h"
+#include "model_path.h"
+#include "esp_wn_models.h"
+#include "esp_vadn_models.h"
+#include "wakeword.h"
+#include "wakeword_verify.h"
+#include "hiesp.h"
+#include "hilexin.h"
+
+static int wake_count = 0;
+static int cancel_count = 0;
+
+static void test_wake_cb(void) {
+    wake_count++;
+}
+
+static void test_cancel_cb(void) {
+    cancel_count++;
+}
+
+// Pick the recording of the packed wake word. Returns NULL if there is no WakeNet or
+// no VADNet model to verify with.
+static const unsigned char *test_wake_sample(size_t *size) {
+    const unsigned char *data = NULL;
+    srmodel_list_t *models = esp_srmodel_init(WAKEWORD_MODEL_PARTITION);
+    if (!models) {
+        return NULL;
+    }
+    char *wn_name = esp_srmodel_filter(models, ESP_WN_PREFIX, NULL);
+    if (wn_name && esp_srmodel_filter(models, ESP_VADN_PREFIX, NULL)) {
+        if (strstr(wn_name, "hiesp")) {
+            data = hiesp;
+            *size = sizeof(hiesp);
+        } else if (strstr(wn_name, "hilexin")) {
+            data = hilexin;
+            *size = sizeof(hilexin);
+        }
+    }
+    esp_srmodel_deinit(models);
+    return data;
+}
+
+// Stream the recording, then trailing silence, until a detection opens a verification window
+static int test_feed_until_window(const unsigned char *data, size_t size, int16_t *frame) {
+    const size_t frame_bytes = WAKEWORD_FRAME_SAMPLES * sizeof(int16_t);
+    int frames = size / frame_bytes + 50;
+    for (int i = 0; i < frames; i++) {
+        if ((i + 1) * frame_bytes <= size) {
+            memcpy(frame, data + i * frame_bytes, frame_bytes);
+        } else {
+            memset(frame, 0, frame_bytes);
+        }
+        wakeword_process_frame(frame);
+        if (wakeword_verify_active()) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+TEST_CASE("wakeword verify window closes over gated silence", "[wakeword]")
+{
+    size_t size = 0;
+    const unsigned char *data = test_wake_sample(&size);
+    if (!data) {
+        TEST_IGNORE_MESSAGE("needs a hiesp or hilexin WakeNet and a VADNet model");
+    }
+    int16_t frame[WAKEWORD_FRAME_SAMPLES];
+    wake_count = 0;
+    cancel_count = 0;
+    TEST_ASSERT_EQUAL(0, wakeword_init_ex(WAKEWORD_MODEL_PARTITION, WAKE_MODE, test_wake_cb));
+    wakeword_set_cancel_callback(test_cancel_cb);
+
+    // trigger: the wake word opens a window
+    TEST_ASSERT_TRUE(test_feed_until_window(data, size, frame));
+    TEST_ASSERT_EQUAL(WAKEWORD_VERIFY_SPECULATIVE ? 1 : 0, wake_count);
+
+    // silence: the noise gate drops every frame, the window must still run out and reject
+    for (int i = 0; i < WAKEWORD_VERIFY_FRAMES; i++) {
+        TEST_ASSERT_EQUAL(0, wakeword_process_gated());
+    }
+    TEST_ASSERT_FALSE(wakeword_verify_active());
+    TEST_ASSERT_EQUAL(WAKEWORD_VERIFY_SPECULATIVE ? 1 : 0, cancel_count);
+
+    // speech: it must not verify the stale detection, and a new wake word is a new detection
+    TEST_ASSERT_TRUE(test_feed_until_window(data, size, frame));
+    TEST_ASSERT_EQUAL(WAKEWORD_VERIFY_SPECULATIVE ? 2 : 0, wake_count);
+    TEST_ASSERT_EQUAL(WAKEWORD_VERIFY_SPECULATIVE ? 1 : 0, cancel_count);
+
+    wakeword_deinit();
+}
@@ -1,33 +1,44 @@
 #include "esp_wn_models.h" 
 #include "wakeword.h"
-#include "mic_i2s.h"
 #include "esp_log.h"
 #include "model_path.h" // Replaced esp_srmodel.h with model_path.h
 #include "esp_wn_iface.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include "esp_timer.h"
+#include "wakeword_profiler.h"
+#include "wakeword_threshold.h"
+#include "wakeword_verify.h"
 
 static const char *TAG = "WakeMultinet";
 
-#define SAMPLE_RATE     16000
-#define BUFFER_SIZE     512
-#define WAKE_MODE       DET_MODE_95
-#define CMD_TIMEOUT     40  // ~0.5s @ 16kHz
-
 static wakeword_callback_t ww_callback = NULL;
+static wakeword_callback_t ww_cancel_callback = NULL;
+static int verify_enabled = 0;
+
+// Start of the frame that produced the detection under verification, for E2E timing
+static int64_t t_detected = 0;
+static uint32_t c_detected = 0;
 
 static srmodel_list_t *sr_models = NULL;
 static const esp_wn_iface_t *wakenet = NULL;
 static model_iface_data_t *wn_handle = NULL;
+static char *wn_model_name = NULL;
+
+void wakeword_set_cancel_callback(wakeword_callback_t cancel_cb) {
+    ww_cancel_callback = cancel_cb;
+}
 
 void wakeword_init(wakeword_callback_t wake_cb) {
+    wakeword_init_ex(WAKEWORD_MODEL_PARTITION, WAKE_MODE, wake_cb);
+}
+
+int wakeword_init_ex(const char *model_path, det_mode_t det_mode, wakeword_callback_t wake_cb) {
     ww_callback = wake_cb;
 
     // Initialize model list from partition
-    sr_models = esp_srmodel_init("model");
+    sr_models = esp_srmodel_init(model_path);
     if (!sr_models) {
         ESP_LOGE(TAG, "Failed to init model list");
-        return;
+        return -1;
     }
 
     // Initialize WakeNet
@@ -35,14 +46,16 @@ void wakeword_init(wakeword_callback_t wake_cb) {
     if (!wn_name) {
         ESP_LOGE(TAG, "No WakeNet model found");
         esp_srmodel_deinit(sr_models);
-        return;
+        sr_models = NULL;
+        return -1;
     } 
 
     int wn_index = esp_srmodel_exists(sr_models, wn_name);
      if (wn_index < 0 || wn_index >= sr_models->num) {
         ESP_LOGE(TAG, "WakeNet model %s not found in list", wn_name);
         esp_srmodel_deinit(sr_models);
-        return;
+        sr_models = NULL;
+        return -1;
     } 
     
     //srmodel_data_t *wn_data = sr_models->model_data[wn_index];//dev says dont need this ,just add name
@@ -51,43 +64,145 @@ void wakeword_init(wakeword_callback_t wake_cb) {
     if (!wakenet) {
         ESP_LOGE(TAG, "Failed to get WakeNet handle for %s", wn_name);
         esp_srmodel_deinit(sr_models);
-        return;
+        sr_models = NULL;
+        return -1;
     } 
  
     //for debugging 
     ESP_LOGI(TAG, "Using WakeNet: %s", wn_name); 
 
-    wn_handle = wakenet->create(wn_name, WAKE_MODE);
+    // maps the model's files when the partition is mapped lazily
+    if (esp_srmodel_acquire(sr_models, wn_name) != 0) {
+        ESP_LOGE(TAG, "Failed to map WakeNet model %s", wn_name);
+        esp_srmodel_deinit(sr_models);
+        sr_models = NULL;
+        wakenet = NULL;
+        return -1;
+    }
+
+    wn_handle = wakenet->create(wn_name, det_mode);
     if (!wn_handle) {
         ESP_LOGE(TAG, "WakeNet creation failed for %s", wn_name);
+        esp_srmodel_release(sr_models, wn_name);
         esp_srmodel_deinit(sr_models);
-        return;
+        sr_models = NULL;
+        wakenet = NULL;
+        return -1;
     }
 
+    wn_model_name = wn_name;
+
+#if WAKEWORD_ADAPTIVE_THRESHOLD
+    wakeword_threshold_init(wakenet, wn_handle, NULL);
+#endif
+    verify_enabled = WAKEWORD_VERIFY_FRAMES > 0 &&
+                     wakeword_verify_init(sr_models, WAKEWORD_VERIFY_FRAMES, WAKEWORD_VERIFY_MIN_SPEECH) == 0;
+    wakeword_profiler_init((uint32_t)((int64_t)WAKEWORD_FRAME_SAMPLES * 1000000 / WAKEWORD_SAMPLE_RATE));
+
     ESP_LOGI(TAG, "WakeNet (%s) and MultiNet (%s) initialized", wn_name, "placeholder");//mn_name
+    return 0;
 }
 
-void wakeword_task(void *arg) {
-    int16_t *buffer = calloc(BUFFER_SIZE, sizeof(int16_t));
-    if (!buffer) {
-        ESP_LOGE(TAG, "Buffer allocation failed");
-        vTaskDelete(NULL);
+static void fire_wake_callback(int64_t t_ready, uint32_t c_ready) {
+    if (!ww_callback) {
         return;
     }
+    int64_t t_cb = esp_timer_get_time();
+    uint32_t c_cb = wakeword_profiler_cycles();
+    wakeword_profiler_record(WW_STAGE_E2E, (uint32_t)(t_cb - t_ready), c_cb - c_ready);
+    ww_callback();
+    wakeword_profiler_record(WW_STAGE_CALLBACK, (uint32_t)(esp_timer_get_time() - t_cb),
+                             wakeword_profiler_cycles() - c_cb);
+}
+
+// Advance an open verification window, frame is NULL for a gated frame.
+// Returns 1 if the wake callback fired.
+static int verify_frame(const int16_t *frame) {
+    ww_verify_result_t res = wakeword_verify_feed(frame, WAKEWORD_FRAME_SAMPLES);
+    if (res == WW_VERIFY_ACCEPT) {
+        ESP_LOGI(TAG, "Wake word verified");
+        if (!WAKEWORD_VERIFY_SPECULATIVE) {
+            fire_wake_callback(t_detected, c_detected);
+            return 1;
+        }
+    } else if (res == WW_VERIFY_REJECT) {
+        ESP_LOGI(TAG, "Wake word rejected by verifier");
+        wakeword_profiler_count_rejection();
+        if (WAKEWORD_VERIFY_SPECULATIVE && ww_cancel_callback) {
+            ww_cancel_callback();
+        }
+    }
+    return 0;
+}
+
+int wakeword_process_frame(int16_t *frame) {
+    if (!wn_handle) {
+        return 0;
+    }
 
-    while (1) {
-        int bytes_read = i2s_mic_read((char *)buffer, BUFFER_SIZE * sizeof(int16_t));
-        if (bytes_read <= 0) continue;
+    int64_t t_ready = esp_timer_get_time();
+    uint32_t c_ready = wakeword_profiler_cycles();
+    int fired = (verify_enabled && wakeword_verify_active()) ? verify_frame(frame) : 0;
 
-        if (wakenet->detect(wn_handle, buffer) == WAKENET_DETECTED) {
-            ESP_LOGI(TAG, "Wake word detected");
-            if (ww_callback) ww_callback();
+    // WakeNet keeps running during verification so its audio history stays continuous
+    int64_t t_start = esp_timer_get_time();
+    uint32_t c_start = wakeword_profiler_cycles();
+    wakenet_state_t state = wakenet->detect(wn_handle, frame);
+    wakeword_profiler_record(WW_STAGE_DETECT, (uint32_t)(esp_timer_get_time() - t_start),
+                             wakeword_profiler_cycles() - c_start);
+
+    if (state != WAKENET_DETECTED) {
+        return fired;
+    }
+    // a detection while the window is still open belongs to the same wake-up: report it
+    // once, but check the speech that follows the latest detection
+    if (verify_enabled && wakeword_verify_active()) {
+        wakeword_verify_start();
+        return fired;
+    }
+
+    ESP_LOGI(TAG, "Wake word detected");
+    wakeword_profiler_count_detection();
+    if (verify_enabled) {
+        t_detected = t_ready;
+        c_detected = c_ready;
+        wakeword_verify_start();
+        if (!WAKEWORD_VERIFY_SPECULATIVE) {
+            return 0;
         }
     }
+    fire_wake_callback(t_ready, c_ready);
+    return 1;
+}
+
+int wakeword_process_gated(void) {
+    if (!wn_handle || !verify_enabled || !wakeword_verify_active()) {
+        return 0;
+    }
+    return verify_frame(NULL);
+}
+
+void wakeword_reset(void) {
+    if (wn_handle) {
+        wakenet->clean(wn_handle);
+    }
+    // drop any open window so it does not spill into the next recording
+    wakeword_verify_abort();
+}
 
-    // Cleanup (not usually reached)
-    free(buffer);
-    wakenet->destroy(wn_handle);
-    esp_srmodel_deinit(sr_models);
-    vTaskDelete(NULL);
-} 
\ No newline at end of file
+void wakeword_deinit(void) {
+    wakeword_threshold_init(NULL, NULL, NULL);
+    wakeword_verify_deinit();
+    verify_enabled = 0;
+    if (wn_handle) {
+        wakenet->destroy(wn_handle);
+        wn_handle = NULL;
+        esp_srmodel_release(sr_models, wn_model_name);
+        wn_model_name = NULL;
+    }
+    if (sr_models) {
+        esp_srmodel_deinit(sr_models);
+        sr_models = NULL;
+    }
+    wakenet = NULL;
+}
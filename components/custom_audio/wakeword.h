@@ -1,7 +1,74 @@
 #pragma once
 
+#include <stdint.h>
+#include "esp_wn_iface.h"
+
+#define WAKEWORD_MODEL_PARTITION  "model"
+#define WAKEWORD_SAMPLE_RATE      16000
+#define WAKEWORD_FRAME_SAMPLES    512       // samples handed to detect() per frame
+#define WAKE_MODE                 DET_MODE_95
+#define WAKEWORD_ADAPTIVE_THRESHOLD  1      // raise detection thresholds with the ambient noise floor
+
+// Second-pass verification: after a detection, VADNet must see speech continue within
+// the next WAKEWORD_VERIFY_FRAMES frames. 0 disables it (or when no VADNet model is packed).
+#define WAKEWORD_VERIFY_FRAMES       12     // ~384 ms
+#define WAKEWORD_VERIFY_MIN_SPEECH   3      // VAD speech chunks needed inside the window
+// 1: fire the wake callback immediately and the cancel callback if verification fails,
+//    so true triggers see no extra latency. 0: hold the wake callback until verified.
+#define WAKEWORD_VERIFY_SPECULATIVE  1
+
+// Power-managed listening: the mic DMA ring holds WAKEWORD_LP_BATCH_FRAMES frames, the task
+// wakes once per batch and runs WakeNet over all of them at WAKEWORD_LP_MAX_FREQ_MHZ, and the CPU
+// scales down in between. Needs CONFIG_PM_ENABLE. Adds up to (batch - 1) frames of detection latency.
+// No light sleep: the I2S driver holds an ESP_PM_APB_FREQ_MAX lock while the mic channel is
+// enabled, and stopping the channel between batches would drop audio, so the CPU idles at 80 MHz.
+#define WAKEWORD_LOW_POWER           0
+#define WAKEWORD_LP_BATCH_FRAMES     4
+#define WAKEWORD_LP_MAX_FREQ_MHZ     240    // WakeNet inference clock
+#define WAKEWORD_LP_MIN_FREQ_MHZ     80     // lowest clock the I2S APB lock allows
+
 typedef void (*wakeword_callback_t)(void);
 //typedef void (*command_callback_t)(const char *command);
 
 void wakeword_init(wakeword_callback_t wake_cb);//, command_callback_t command_cb
 void wakeword_task(void *arg);
+
+/**
+ * @brief Set the callback fired when a speculatively reported detection fails verification.
+ *        The handler should abort whatever the wake callback started.
+ */
+void wakeword_set_cancel_callback(wakeword_callback_t cancel_cb);
+
+/**
+ * @brief Load models from a partition label (or directory on the linux target) and create WakeNet.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int wakeword_init_ex(const char *model_path, det_mode_t det_mode, wakeword_callback_t wake_cb);
+
+/**
+ * @brief Run one frame of WAKEWORD_FRAME_SAMPLES through WakeNet and the verifier, profile it
+ *        and fire the callbacks. This is the per-frame path of wakeword_task, shared with the
+ *        offline benchmark.
+ *
+ * @return 1 if the wake callback fired in this frame, 0 otherwise
+ */
+int wakeword_process_frame(int16_t *frame);
+
+/**
+ * @brief Account for a frame the noise gate silenced. WakeNet is skipped, but an open
+ *        verification window still counts the frame as silence, so it closes on time.
+ *
+ * @return 1 if the wake callback fired in this frame, 0 otherwise
+ */
+int wakeword_process_gated(void);
+
+/**
+ * @brief Clear WakeNet's internal audio history, e.g. between unrelated recordings.
+ */
+void wakeword_reset(void);
+
+/**
+ * @brief Destroy WakeNet and release the model list.
+ */
+void wakeword_deinit(void);
@@ -0,0 +1,165 @@
+#include "wakeword_profiler.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+
+static const char *stage_names[WW_STAGE_MAX] = {
+    [WW_STAGE_READ]     = "read",
+    [WW_STAGE_DETECT]   = "detect",
+    [WW_STAGE_CALLBACK] = "callback",
+    [WW_STAGE_E2E]      = "e2e",
+};
+
+static portMUX_TYPE prof_lock = portMUX_INITIALIZER_UNLOCKED;
+static ww_profiler_snapshot_t prof;
+
+static inline int hist_bucket(uint32_t us)
+{
+    int b = 0;
+    while (us > 1 && b < WW_PROF_HIST_BUCKETS - 1) {
+        us >>= 1;
+        b++;
+    }
+    return b;
+}
+
+void wakeword_profiler_init(uint32_t frame_us)
+{
+    portENTER_CRITICAL(&prof_lock);
+    prof.frame_us = frame_us;
+    portEXIT_CRITICAL(&prof_lock);
+    wakeword_profiler_reset();
+}
+
+void wakeword_profiler_reset(void)
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&prof_lock);
+    uint32_t frame_us = prof.frame_us;
+    memset(&prof, 0, sizeof(prof));
+    for (int i = 0; i < WW_STAGE_MAX; i++) {
+        prof.stage[i].min_us = UINT32_MAX;
+    }
+    prof.frame_us = frame_us;
+    prof.since_us = now;
+    portEXIT_CRITICAL(&prof_lock);
+}
+
+void wakeword_profiler_record(ww_stage_t stage, uint32_t us, uint32_t cycles)
+{
+    if (stage >= WW_STAGE_MAX) {
+        return;
+    }
+    int bucket = hist_bucket(us);
+
+    portENTER_CRITICAL(&prof_lock);
+    ww_stage_stats_t *s = &prof.stage[stage];
+    s->count++;
+    s->last_us = us;
+    s->total_us += us;
+    s->total_cycles += cycles;
+    if (us < s->min_us) s->min_us = us;
+    if (us > s->max_us) s->max_us = us;
+    if (cycles > s->max_cycles) s->max_cycles = cycles;
+    s->hist[bucket]++;
+
+    if (stage == WW_STAGE_DETECT) {
+        prof.frames++;
+        if (prof.frame_us && us > prof.frame_us) {
+            prof.missed_deadlines++;
+        }
+    }
+    portEXIT_CRITICAL(&prof_lock);
+}
+
+void wakeword_profiler_add_active(uint32_t us)
+{
+    portENTER_CRITICAL(&prof_lock);
+    prof.wakeups++;
+    prof.active_us += us;
+    portEXIT_CRITICAL(&prof_lock);
+}
+
+void wakeword_profiler_count_detection(void)
+{
+    portENTER_CRITICAL(&prof_lock);
+    prof.detections++;
+    portEXIT_CRITICAL(&prof_lock);
+}
+
+void wakeword_profiler_count_rejection(void)
+{
+    portENTER_CRITICAL(&prof_lock);
+    prof.rejections++;
+    portEXIT_CRITICAL(&prof_lock);
+}
+
+void wakeword_profiler_snapshot(ww_profiler_snapshot_t *out)
+{
+    if (!out) {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&prof_lock);
+    *out = prof;
+    portEXIT_CRITICAL(&prof_lock);
+
+    out->now_us = now;
+}
+
+// Append formatted text, tracking the write position. Returns -1 once the buffer is full.
+static int json_append(char *buf, size_t len, int pos, const char *fmt, ...)
+{
+    if (pos < 0 || (size_t)pos >= len) {
+        return -1;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + pos, len - pos, fmt, args);
+    va_end(args);
+    if (n < 0 || (size_t)(pos + n) >= len) {
+        return -1;
+    }
+    return pos + n;
+}
+
+int wakeword_profiler_to_json(const ww_profiler_snapshot_t *snap, char *buf, size_t len)
+{
+    if (!snap || !buf || len == 0) {
+        return -1;
+    }
+
+    int64_t window_us = snap->now_us - snap->since_us;
+    double duty_pct = window_us > 0 ? 100.0 * (double)snap->active_us / (double)window_us : 0.0;
+
+    int pos = json_append(buf, len, 0,
+                          "{\"window_us\":%lld,\"frame_us\":%lu,\"frames\":%lu,\"missed\":%lu,\"detections\":%lu,\"rejections\":%lu,",
+                          (long long)window_us, (unsigned long)snap->frame_us,
+                          (unsigned long)snap->frames, (unsigned long)snap->missed_deadlines,
+                          (unsigned long)snap->detections, (unsigned long)snap->rejections);
+    pos = json_append(buf, len, pos, "\"wakeups\":%lu,\"active_us\":%llu,\"duty_pct\":%.2f,\"stages\":{",
+                      (unsigned long)snap->wakeups, (unsigned long long)snap->active_us, duty_pct);
+
+    for (int i = 0; i < WW_STAGE_MAX; i++) {
+        const ww_stage_stats_t *s = &snap->stage[i];
+        uint32_t avg_us = s->count ? (uint32_t)(s->total_us / s->count) : 0;
+        uint32_t avg_cycles = s->count ? (uint32_t)(s->total_cycles / s->count) : 0;
+        uint32_t min_us = s->count ? s->min_us : 0;
+
+        pos = json_append(buf, len, pos,
+                          "%s\"%s\":{\"n\":%lu,\"avg_us\":%lu,\"min_us\":%lu,\"max_us\":%lu,\"avg_cycles\":%lu,\"max_cycles\":%lu,\"hist\":[",
+                          i ? "," : "", stage_names[i], (unsigned long)s->count, (unsigned long)avg_us,
+                          (unsigned long)min_us, (unsigned long)s->max_us, (unsigned long)avg_cycles,
+                          (unsigned long)s->max_cycles);
+        for (int b = 0; b < WW_PROF_HIST_BUCKETS; b++) {
+            pos = json_append(buf, len, pos, "%s%lu", b ? "," : "", (unsigned long)s->hist[b]);
+        }
+        pos = json_append(buf, len, pos, "]}");
+    }
+
+    return json_append(buf, len, pos, "}}");
+}
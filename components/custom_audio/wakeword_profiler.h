@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sdkconfig.h"
+
+// CPU cycle counter used for stage timing; the linux target (offline benchmark) has none
+#if CONFIG_IDF_TARGET_LINUX
+#define wakeword_profiler_cycles()  ((uint32_t)0)
+#else
+#include "esp_cpu.h"
+#define wakeword_profiler_cycles()  esp_cpu_get_cycle_count()
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Stages of the wakeword pipeline that are timed per frame
+typedef enum {
+    WW_STAGE_READ = 0,   // time blocked in i2s_mic_read() waiting for a frame
+    WW_STAGE_DETECT,     // time spent inside wakenet->detect()
+    WW_STAGE_CALLBACK,   // time spent inside the wake word callback
+    WW_STAGE_E2E,        // frame ready -> wake word callback entered
+    WW_STAGE_MAX
+} ww_stage_t;
+
+// Histogram bucket i counts samples in [2^i, 2^(i+1)) us, the last bucket is open ended
+#define WW_PROF_HIST_BUCKETS 16
+
+typedef struct {
+    uint32_t count;
+    uint32_t last_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint64_t total_cycles;
+    uint32_t max_cycles;
+    uint32_t hist[WW_PROF_HIST_BUCKETS];
+} ww_stage_stats_t;
+
+typedef struct {
+    ww_stage_stats_t stage[WW_STAGE_MAX];
+    uint32_t frames;            // frames passed to detect()
+    uint32_t missed_deadlines;  // frames whose detect() took longer than frame_us
+    uint32_t detections;        // WAKENET_DETECTED results
+    uint32_t rejections;        // detections the second-pass verifier turned down
+    uint32_t frame_us;          // audio duration of one frame
+    uint32_t wakeups;           // times the listening task woke up to process audio
+    uint64_t active_us;         // time spent processing, i.e. not blocked waiting for audio
+    int64_t since_us;           // esp_timer time of the last reset
+    int64_t now_us;             // esp_timer time the snapshot was taken
+} ww_profiler_snapshot_t;
+
+/**
+ * @brief Reset all counters and set the real-time budget of one frame.
+ *
+ * @param frame_us  Audio duration of one detect() frame in microseconds
+ */
+void wakeword_profiler_init(uint32_t frame_us);
+
+/**
+ * @brief Clear counters, keeping the frame budget.
+ */
+void wakeword_profiler_reset(void);
+
+/**
+ * @brief Record one measurement for a stage.
+ *        WW_STAGE_DETECT samples also count a frame and check it against the frame budget.
+ */
+void wakeword_profiler_record(ww_stage_t stage, uint32_t us, uint32_t cycles);
+
+/**
+ * @brief Account one wake-up of the listening task and the time it stayed awake.
+ *        active_us / (now_us - since_us) is the CPU duty cycle of the listening path.
+ */
+void wakeword_profiler_add_active(uint32_t us);
+
+/**
+ * @brief Count one wake word detection.
+ */
+void wakeword_profiler_count_detection(void);
+
+/**
+ * @brief Count one detection rejected by the verifier.
+ */
+void wakeword_profiler_count_rejection(void);
+
+/**
+ * @brief Copy a consistent view of the counters, safe to call from any task.
+ */
+void wakeword_profiler_snapshot(ww_profiler_snapshot_t *out);
+
+/**
+ * @brief Format a snapshot as compact JSON, e.g. for publishing over MQTT.
+ *
+ * @return Number of characters written (excluding '\0'), or -1 if buf is too small
+ */
+int wakeword_profiler_to_json(const ww_profiler_snapshot_t *snap, char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
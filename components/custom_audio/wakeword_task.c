@@ -0,0 +1,129 @@
+#include "wakeword.h"
+#include "mic_i2s.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_pm.h"
+#include "sdkconfig.h"
+#include "wakeword_profiler.h"
+#include "wakeword_threshold.h"
+
+static const char *TAG = "WakeMultinet";
+
+#if WAKEWORD_LOW_POWER
+static esp_pm_lock_handle_t pm_lock = NULL;
+
+// Enable DFS and create the lock held while a batch is processed. Light sleep stays off,
+// the I2S driver blocks it for as long as the mic channel is enabled.
+static void wakeword_pm_init(void) {
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_cfg = {
+        .max_freq_mhz = WAKEWORD_LP_MAX_FREQ_MHZ,
+        .min_freq_mhz = WAKEWORD_LP_MIN_FREQ_MHZ,
+        .light_sleep_enable = false,
+    };
+    esp_err_t err = esp_pm_configure(&pm_cfg);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "esp_pm_configure failed (%d), listening at full power", err);
+        return;
+    }
+    err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "wakeword", &pm_lock);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "PM lock creation failed (%d)", err);
+        pm_lock = NULL;
+    }
+#else
+    ESP_LOGW(TAG, "CONFIG_PM_ENABLE is off, low-power listening only batches reads");
+#endif
+}
+
+static void wakeword_task_batched(void) {
+    const int nframes = WAKEWORD_LP_BATCH_FRAMES;
+    int16_t *buffer = calloc((size_t)WAKEWORD_FRAME_SAMPLES * nframes, sizeof(int16_t));
+    i2s_mic_stats_t *stats = calloc(nframes, sizeof(i2s_mic_stats_t));
+    if (!buffer || !stats) {
+        ESP_LOGE(TAG, "Buffer allocation failed");
+        free(buffer);
+        free(stats);
+        return;
+    }
+
+    wakeword_pm_init();
+    ESP_LOGI(TAG, "Low-power listening, %d frames per wake-up", nframes);
+
+    while (1) {
+        int64_t t_start = esp_timer_get_time();
+        uint32_t c_start = wakeword_profiler_cycles();
+        // blocks until the DMA ring has a full batch; nothing holds the PM lock meanwhile
+        int got = i2s_mic_read_batch(buffer, WAKEWORD_FRAME_SAMPLES, nframes, stats);
+        int64_t t_awake = esp_timer_get_time();
+        wakeword_profiler_record(WW_STAGE_READ, (uint32_t)(t_awake - t_start),
+                                 wakeword_profiler_cycles() - c_start);
+        if (got <= 0) {
+            continue;
+        }
+
+        if (pm_lock) {
+            esp_pm_lock_acquire(pm_lock);
+        }
+        for (int i = 0; i < got; i++) {
+#if WAKEWORD_ADAPTIVE_THRESHOLD
+            wakeword_threshold_update(stats[i].rms_dbfs);
+#endif
+            if (!stats[i].gated) {
+                wakeword_process_frame(buffer + i * WAKEWORD_FRAME_SAMPLES);
+            } else {
+                wakeword_process_gated();
+            }
+        }
+        if (pm_lock) {
+            esp_pm_lock_release(pm_lock);
+        }
+        wakeword_profiler_add_active((uint32_t)(esp_timer_get_time() - t_awake));
+    }
+}
+#endif
+
+static void wakeword_task_continuous(void) {
+    int16_t *buffer = calloc(WAKEWORD_FRAME_SAMPLES, sizeof(int16_t));
+    if (!buffer) {
+        ESP_LOGE(TAG, "Buffer allocation failed");
+        return;
+    }
+
+    while (1) {
+        int64_t t_start = esp_timer_get_time();
+        uint32_t c_start = wakeword_profiler_cycles();
+        int bytes_read = i2s_mic_read((char *)buffer, WAKEWORD_FRAME_SAMPLES * sizeof(int16_t));
+        int64_t t_awake = esp_timer_get_time();
+        wakeword_profiler_record(WW_STAGE_READ, (uint32_t)(t_awake - t_start),
+                                 wakeword_profiler_cycles() - c_start);
+
+#if WAKEWORD_ADAPTIVE_THRESHOLD
+        // gated frames are the quietest ones, they must feed the noise floor too
+        i2s_mic_stats_t mic_stats;
+        i2s_mic_get_stats(&mic_stats);
+        wakeword_threshold_update(mic_stats.rms_dbfs);
+#endif
+        if (bytes_read > 0) {
+            wakeword_process_frame(buffer);
+        } else if (bytes_read == 0) {
+            wakeword_process_gated();
+        }
+        wakeword_profiler_add_active((uint32_t)(esp_timer_get_time() - t_awake));
+    }
+
+    // Cleanup (not usually reached)
+    free(buffer);
+    wakeword_deinit();
+}
+
+void wakeword_task(void *arg) {
+#if WAKEWORD_LOW_POWER
+    wakeword_task_batched();
+#else
+    wakeword_task_continuous();
+#endif
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,124 @@
+#include "wakeword_threshold.h"
+#include <stdio.h>
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+
+static const char *TAG = "WW_THRESHOLD";
+
+static portMUX_TYPE th_lock = portMUX_INITIALIZER_UNLOCKED;
+static ww_threshold_cfg_t th_cfg = WW_THRESHOLD_DEFAULT_CONFIG();
+static ww_operating_point_t th_op;
+static const esp_wn_iface_t *th_wn = NULL;
+static model_iface_data_t *th_handle = NULL;
+
+static inline float clampf(float v, float lo, float hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+void wakeword_threshold_init(const esp_wn_iface_t *wn, model_iface_data_t *handle, const ww_threshold_cfg_t *cfg)
+{
+    ww_threshold_cfg_t defaults = WW_THRESHOLD_DEFAULT_CONFIG();
+    ww_operating_point_t op = {0};
+
+    op.noise_floor_db = defaults.floor_quiet_db;
+    if (wn && handle) {
+        op.word_num = wn->get_word_num(handle);
+        if (op.word_num > WW_THRESHOLD_MAX_WORDS) {
+            ESP_LOGW(TAG, "model has %d words, controlling the first %d", op.word_num, WW_THRESHOLD_MAX_WORDS);
+            op.word_num = WW_THRESHOLD_MAX_WORDS;
+        }
+        // WakeNet word indices start at 1
+        for (int i = 0; i < op.word_num; i++) {
+            op.base[i] = wn->get_det_threshold(handle, i + 1);
+            op.threshold[i] = op.base[i];
+        }
+    }
+
+    portENTER_CRITICAL(&th_lock);
+    th_cfg = cfg ? *cfg : defaults;
+    th_op = op;
+    th_op.noise_floor_db = th_cfg.floor_quiet_db;
+    th_wn = wn;
+    th_handle = handle;
+    portEXIT_CRITICAL(&th_lock);
+
+    for (int i = 0; i < op.word_num; i++) {
+        ESP_LOGI(TAG, "word %d default threshold %.4f", i + 1, op.base[i]);
+    }
+}
+
+void wakeword_threshold_update(float frame_dbfs)
+{
+    if (!th_wn || !th_handle || th_op.word_num == 0) {
+        return;
+    }
+
+    // Asymmetric tracker: follows drops quickly and rises slowly, so speech bursts
+    // barely move the estimate while a steadily louder room does.
+    float floor_db = th_op.noise_floor_db;
+    float rate = frame_dbfs < floor_db ? th_cfg.fall_rate : th_cfg.rise_rate;
+    floor_db += rate * (frame_dbfs - floor_db);
+
+    float span = th_cfg.floor_loud_db - th_cfg.floor_quiet_db;
+    float level = span > 0 ? clampf((floor_db - th_cfg.floor_quiet_db) / span, 0.0f, 1.0f) : 0.0f;
+    float offset = level * th_cfg.max_offset;
+
+    float next[WW_THRESHOLD_MAX_WORDS];
+    int changed = 0;
+    for (int i = 0; i < th_op.word_num; i++) {
+        next[i] = clampf(th_op.base[i] + offset, th_cfg.th_min, th_cfg.th_max);
+        float delta = fabsf(next[i] - th_op.threshold[i]);
+        // always settle back exactly on the default once the room is quiet again
+        if (delta >= th_cfg.hysteresis || (offset == 0.0f && delta > 0.0f)) {
+            changed = 1;
+        }
+    }
+
+    // Only this task calls set_det_threshold(), the lock just keeps readers consistent
+    if (changed) {
+        for (int i = 0; i < th_op.word_num; i++) {
+            th_wn->set_det_threshold(th_handle, next[i], i + 1);
+        }
+        ESP_LOGD(TAG, "noise floor %.1f dBFS -> threshold offset %.3f", floor_db, offset);
+    }
+
+    portENTER_CRITICAL(&th_lock);
+    th_op.noise_floor_db = floor_db;
+    if (changed) {
+        for (int i = 0; i < th_op.word_num; i++) {
+            th_op.threshold[i] = next[i];
+        }
+        th_op.updates++;
+    }
+    portEXIT_CRITICAL(&th_lock);
+}
+
+void wakeword_threshold_get(ww_operating_point_t *op)
+{
+    if (!op) {
+        return;
+    }
+    portENTER_CRITICAL(&th_lock);
+    *op = th_op;
+    portEXIT_CRITICAL(&th_lock);
+}
+
+int wakeword_threshold_to_json(const ww_operating_point_t *op, char *buf, size_t len)
+{
+    if (!op || !buf || len == 0) {
+        return -1;
+    }
+
+    int pos = snprintf(buf, len, "{\"noise_floor_db\":%.1f,\"updates\":%lu,\"thresholds\":[",
+                       op->noise_floor_db, (unsigned long)op->updates);
+    for (int i = 0; i < op->word_num && pos >= 0 && (size_t)pos < len; i++) {
+        pos += snprintf(buf + pos, len - pos, "%s{\"word\":%d,\"base\":%.4f,\"current\":%.4f}",
+                        i ? "," : "", i + 1, op->base[i], op->threshold[i]);
+    }
+    if (pos >= 0 && (size_t)pos < len) {
+        pos += snprintf(buf + pos, len - pos, "]}");
+    }
+    return (pos < 0 || (size_t)pos >= len) ? -1 : pos;
+}
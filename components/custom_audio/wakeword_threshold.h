@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stddef.h>
+#include "esp_wn_iface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WW_THRESHOLD_MAX_WORDS 4
+
+// Noise-floor driven threshold controller. In a quiet room the model's own thresholds are
+// used; as the ambient floor rises towards floor_loud_db each word's threshold is raised by
+// up to max_offset, clamped to [th_min, th_max], to suppress false wakes in noise.
+typedef struct {
+    float floor_quiet_db;   // noise floor (dBFS) at or below which no offset is applied
+    float floor_loud_db;    // noise floor (dBFS) at or above which max_offset is applied
+    float max_offset;       // largest threshold increase over the model default
+    float th_min;           // lower bound for any threshold
+    float th_max;           // upper bound for any threshold
+    float fall_rate;        // per-frame smoothing when the level drops below the floor
+    float rise_rate;        // per-frame smoothing when the level is above the floor
+    float hysteresis;       // minimum threshold change before set_det_threshold() is called
+} ww_threshold_cfg_t;
+
+#define WW_THRESHOLD_DEFAULT_CONFIG() {  \
+    .floor_quiet_db = -60.0f,            \
+    .floor_loud_db  = -30.0f,            \
+    .max_offset     = 0.1f,              \
+    .th_min         = 0.4f,              \
+    .th_max         = 0.9999f,           \
+    .fall_rate      = 0.1f,              \
+    .rise_rate      = 0.002f,            \
+    .hysteresis     = 0.005f,            \
+}
+
+typedef struct {
+    float noise_floor_db;                       // current ambient estimate
+    int word_num;                               // number of wake words in the model
+    float base[WW_THRESHOLD_MAX_WORDS];         // model default thresholds
+    float threshold[WW_THRESHOLD_MAX_WORDS];    // thresholds currently applied
+    uint32_t updates;                           // set_det_threshold() calls made
+} ww_operating_point_t;
+
+/**
+ * @brief Attach the controller to a WakeNet instance and read its default thresholds.
+ *
+ * @param cfg  Controller configuration, or NULL for WW_THRESHOLD_DEFAULT_CONFIG()
+ */
+void wakeword_threshold_init(const esp_wn_iface_t *wn, model_iface_data_t *handle, const ww_threshold_cfg_t *cfg);
+
+/**
+ * @brief Feed the level of one captured frame and re-apply thresholds if they moved.
+ *        Called from the capture task for every frame, including gated ones.
+ */
+void wakeword_threshold_update(float frame_dbfs);
+
+/**
+ * @brief Copy the current operating point, safe to call from any task.
+ */
+void wakeword_threshold_get(ww_operating_point_t *op);
+
+/**
+ * @brief Format an operating point as compact JSON.
+ *
+ * @return Number of characters written (excluding '\0'), or -1 if buf is too small
+ */
+int wakeword_threshold_to_json(const ww_operating_point_t *op, char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
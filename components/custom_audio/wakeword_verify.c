@@ -0,0 +1,141 @@
+#include "wakeword_verify.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_vadn_iface.h"
+#include "esp_vadn_models.h"
+
+static const char *TAG = "WW_VERIFY";
+
+static const esp_vadn_iface_t *vadnet = NULL;
+static model_iface_data_t *vad_handle = NULL;
+static srmodel_list_t *vad_models = NULL;   // list the model was acquired from
+static char *vad_model_name = NULL;
+
+// VADNet's chunk size need not match the wakeword frame, so frames are
+// accumulated here and scored one VAD chunk at a time.
+static int16_t *vad_buf = NULL;
+static int vad_chunk = 0;
+static int vad_fill = 0;
+
+static int window_frames = 0;
+static int min_speech = 0;
+static int frames_left = 0;
+static int speech_chunks = 0;
+
+int wakeword_verify_init(srmodel_list_t *models, int window, int speech) {
+    char *vad_name = esp_srmodel_filter(models, ESP_VADN_PREFIX, NULL);
+    if (!vad_name) {
+        ESP_LOGW(TAG, "No VADNet model found, detections will not be verified");
+        return -1;
+    }
+
+    vadnet = esp_vadn_handle_from_name(vad_name);
+    if (!vadnet) {
+        ESP_LOGE(TAG, "Failed to get VADNet handle for %s", vad_name);
+        return -1;
+    }
+
+    if (esp_srmodel_acquire(models, vad_name) != 0) {
+        ESP_LOGE(TAG, "Failed to map VADNet model %s", vad_name);
+        vadnet = NULL;
+        return -1;
+    }
+
+    vad_handle = vadnet->create(vad_name, VAD_MODE_0, 1, 32, 64);
+    if (!vad_handle) {
+        ESP_LOGE(TAG, "VADNet creation failed for %s", vad_name);
+        esp_srmodel_release(models, vad_name);
+        vadnet = NULL;
+        return -1;
+    }
+    vad_models = models;
+    vad_model_name = vad_name;
+
+    vad_chunk = vadnet->get_samp_chunksize(vad_handle);
+    vad_buf = calloc(vad_chunk, sizeof(int16_t));
+    if (!vad_buf) {
+        ESP_LOGE(TAG, "VAD buffer allocation failed");
+        wakeword_verify_deinit();
+        return -1;
+    }
+
+    window_frames = window;
+    min_speech = speech;
+    frames_left = 0;
+    ESP_LOGI(TAG, "Verifying detections with %s: %d frames, %d speech chunks of %d samples",
+             vad_name, window_frames, min_speech, vad_chunk);
+    return 0;
+}
+
+void wakeword_verify_start(void) {
+    if (!vad_handle) {
+        return;
+    }
+    vadnet->clean(vad_handle);
+    vad_fill = 0;
+    speech_chunks = 0;
+    frames_left = window_frames;
+}
+
+void wakeword_verify_abort(void) {
+    frames_left = 0;
+}
+
+int wakeword_verify_active(void) {
+    return frames_left > 0;
+}
+
+ww_verify_result_t wakeword_verify_feed(const int16_t *frame, int samples) {
+    if (frames_left <= 0) {
+        return WW_VERIFY_PENDING;
+    }
+
+    // a gated frame is silence: it counts against the window but is not worth a VAD pass,
+    // and the partial chunk before it no longer continues into the next frame
+    if (!frame) {
+        vad_fill = 0;
+        samples = 0;
+    }
+    while (samples > 0) {
+        int n = vad_chunk - vad_fill;
+        if (n > samples) {
+            n = samples;
+        }
+        memcpy(vad_buf + vad_fill, frame, n * sizeof(int16_t));
+        vad_fill += n;
+        frame += n;
+        samples -= n;
+
+        if (vad_fill == vad_chunk) {
+            vad_fill = 0;
+            if (vadnet->detect(vad_handle, vad_buf) == VAD_SPEECH) {
+                speech_chunks++;
+            }
+        }
+    }
+
+    if (speech_chunks >= min_speech) {
+        frames_left = 0;
+        return WW_VERIFY_ACCEPT;
+    }
+    if (--frames_left == 0) {
+        ESP_LOGI(TAG, "Rejected: %d/%d speech chunks", speech_chunks, min_speech);
+        return WW_VERIFY_REJECT;
+    }
+    return WW_VERIFY_PENDING;
+}
+
+void wakeword_verify_deinit(void) {
+    if (vad_handle) {
+        vadnet->destroy(vad_handle);
+        vad_handle = NULL;
+        esp_srmodel_release(vad_models, vad_model_name);
+        vad_models = NULL;
+        vad_model_name = NULL;
+    }
+    free(vad_buf);
+    vad_buf = NULL;
+    vadnet = NULL;
+    frames_left = 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+#include "model_path.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    WW_VERIFY_PENDING = 0,  // window still open
+    WW_VERIFY_ACCEPT,       // enough speech followed the wake word
+    WW_VERIFY_REJECT,       // window closed without enough speech
+} ww_verify_result_t;
+
+/**
+ * @brief Create the VADNet instance used for second-pass verification.
+ *
+ * @param models          Model list that was loaded for WakeNet
+ * @param window_frames   Number of wakeword frames checked after a detection
+ * @param min_speech      VAD speech chunks needed inside the window to accept
+ *
+ * @return 0 on success, -1 if no VADNet model is available (verification disabled)
+ */
+int wakeword_verify_init(srmodel_list_t *models, int window_frames, int min_speech);
+
+/**
+ * @brief Open a verification window after a WakeNet detection.
+ */
+void wakeword_verify_start(void);
+
+/**
+ * @brief Close an open window without a verdict.
+ */
+void wakeword_verify_abort(void);
+
+/**
+ * @brief Whether a verification window is open.
+ */
+int wakeword_verify_active(void);
+
+/**
+ * @brief Feed one wakeword frame into the open window.
+ *
+ * @param frame    Frame samples, or NULL for a frame the noise gate silenced. Every frame,
+ *                 gated or not, must be fed so the window closes after window_frames frames.
+ * @param samples  Number of samples in frame
+ *
+ * @return WW_VERIFY_ACCEPT as soon as enough speech was seen, WW_VERIFY_REJECT when the
+ *         window runs out, WW_VERIFY_PENDING otherwise
+ */
+ww_verify_result_t wakeword_verify_feed(const int16_t *frame, int samples);
+
+/**
+ * @brief Destroy the VADNet instance.
+ */
+void wakeword_verify_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
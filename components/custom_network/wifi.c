@@ -28,7 +28,7 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
     }
 }
 
-void wifi_init_sta(void)
+void wifi_start_sta(void)
 {
     // Step 1: Initialize NVS
     esp_err_t ret = nvs_flash_init();
@@ -78,9 +78,23 @@ void wifi_init_sta(void)
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
     ESP_ERROR_CHECK(esp_wifi_start());
+}
+
+bool wifi_wait_connected(TickType_t timeout)
+{
+    if (!s_wifi_event_group) {
+        return false;
+    }
+    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group, WIFI_CONNECTED_BIT, pdFALSE, pdFALSE, timeout);
+    return (bits & WIFI_CONNECTED_BIT) != 0;
+}
+
+void wifi_init_sta(void)
+{
+    wifi_start_sta();
 
     // Step 6: Wait for connection
     ESP_LOGI(TAG, "Waiting for Wi-Fi connection...");
-    xEventGroupWaitBits(s_wifi_event_group, WIFI_CONNECTED_BIT, pdFALSE, pdFALSE, portMAX_DELAY);
+    wifi_wait_connected(portMAX_DELAY);
     ESP_LOGI(TAG, "Wi-Fi connected successfully");
 }
\ No newline at end of file
@@ -1,6 +1,14 @@
 #ifndef WIFI_H
 #define WIFI_H
 
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+
+// Initialize NVS and the Wi-Fi station and start associating, without waiting for an IP
+void wifi_start_sta(void);
+// Wait until the station has an IP; returns false on timeout
+bool wifi_wait_connected(TickType_t timeout);
+// wifi_start_sta() followed by wifi_wait_connected(portMAX_DELAY)
 void wifi_init_sta(void);
 
 #endif
@@ -16,6 +16,15 @@ void load_config(void);
  
 #define mqtt_url  "mqtt://10.4.12.179:1883"
 
+// Wakeword profiler publishing
+#define WAKEWORD_STATS_INTERVAL_MS  60000
+#define WAKEWORD_STATS_JSON_SIZE    2048
+
+// Startup: wakeword init and listening run on this core, Wi-Fi stays on core 0
+#define WAKEWORD_CORE               1
+// How long audio of a wake event heard before the network is up is kept for upload
+#define EARLY_WAKE_UPLOAD_TIMEOUT_MS 30000
+
 #ifdef __cplusplus
 }
 #endif
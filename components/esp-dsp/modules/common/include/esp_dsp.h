@@ -28,12 +28,14 @@ extern "C"
 #include "dsps_dotprod.h"
 #include "dsps_math.h"
 #include "dsps_fir.h"
+#include "dsps_fir_fd.h"
 #include "dsps_resampler.h"
 #include "dsps_biquad.h"
 #include "dsps_biquad_gen.h"
 #include "dsps_wind.h"
 #include "dsps_conv.h"
 #include "dsps_corr.h"
+#include "dsps_conv_fft.h"
 
 #include "dsps_d_gen.h"
 #include "dsps_h_gen.h"
@@ -43,6 +45,10 @@ extern "C"
 
 #include "dsps_fft2r.h"
 #include "dsps_fft4r.h"
+#include "dsps_fft_plan.h"
+#include "dsps_fft_mr.h"
+#include "dsps_rfft.h"
+#include "dsps_stft.h"
 #include "dsps_dct.h"
 
 // Matrix operations
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsp_block_buff_H_
+#define _dsp_block_buff_H_
+
+#include <string.h>
+#include "dsp_err.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * The buffers of the FFT based engines (STFT, FFT convolution, frequency domain FIR) are carved
+ * from one memalign(16, ...) block. Every buffer is rounded up to a multiple of 4 floats,
+ * so every buffer keeps the 16 bytes alignment, that the optimized FFT kernels need.
+ */
+#define DSP_BLOCK_BUFF_SIZE(len) (((len) + 3) & ~3)
+
+/**
+ * Returns the buffer of len floats at *mem and moves *mem to the next aligned buffer.
+ */
+static inline float *dsp_block_buff_carve(float **mem, int len)
+{
+    float *result = *mem;
+    *mem += DSP_BLOCK_BUFF_SIZE(len);
+    return result;
+}
+
+typedef esp_err_t (*dsp_block_buff_func_t)(void *arg);
+
+/**
+ * Streams any number of samples through an engine, that processes blocks of block_len samples.
+ * The input is copied to in_block, the output is read from out_block, the result of the previous block.
+ * When a block is complete, block_func(arg) calculates the new out_block. *pos is the number of samples
+ * of the current block. The output is delayed by block_len samples.
+ * The input is stored before the output is written, so the input and output arrays could be the same.
+ */
+static inline esp_err_t dsp_block_buff_stream(const float *input, float *output, int len, float *in_block, const float *out_block,
+        int block_len, int *pos, dsp_block_buff_func_t block_func, void *arg)
+{
+    while (len > 0) {
+        int count = block_len - *pos;
+        if (count > len) {
+            count = len;
+        }
+        memcpy(&in_block[*pos], input, count * sizeof(float));
+        memcpy(output, &out_block[*pos], count * sizeof(float));
+        *pos += count;
+        input += count;
+        output += count;
+        len -= count;
+        if (*pos == block_len) {
+            esp_err_t result = block_func(arg);
+            if (result != ESP_OK) {
+                return result;
+            }
+            *pos = 0;
+        }
+    }
+    return ESP_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsp_block_buff_H_
@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_conv_fft.h"
+#include "dsps_conv.h"
+#include "dsps_corr.h"
+#include "dsps_ccorr.h"
+#include "dsp_common.h"
+#include "dsp_block_buff.h"
+#include <stdint.h>
+#include <string.h>
+#include <malloc.h>
+
+int dsps_conv_fft_len(int kernlen, int outlen)
+{
+    if ((kernlen < DSPS_CONV_FFT_MIN_KERNEL) || (outlen <= 0)) {
+        return 0;
+    }
+    // Costs in multiply-accumulate operations: a real FFT of N samples takes about 1.25*N*log2(N),
+    // every block takes two FFTs and the multiplication of the spectra
+    float best_cost = (float)kernlen * outlen;
+    int best_len = 0;
+    for (int N = 8, log2N = 3; N <= DSPS_CONV_FFT_MAX_LEN; N <<= 1, log2N++) {
+        int block = N - kernlen + 1;
+        if (block < kernlen) {
+            continue;
+        }
+        int blocks = outlen / block + ((outlen % block) != 0);
+        float cost = (float)blocks * N * (2.5f * log2N + 3) + 1.25f * N * log2N;
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_len = N;
+        }
+        // One block covers the whole output
+        if (blocks == 1) {
+            break;
+        }
+    }
+    return best_len;
+}
+
+static esp_err_t dsps_conv_fft_init_(dsps_conv_fft_t *conv, const float *kernel, int kernlen, int fft_len, int reverse)
+{
+    memset(conv, 0, sizeof(dsps_conv_fft_t));
+    if ((kernel == NULL) || (kernlen <= 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (fft_len == 0) {
+        fft_len = dsps_conv_fft_len(kernlen, INT32_MAX);
+        if (fft_len == 0) {
+            fft_len = 8;
+            while (fft_len < 2 * kernlen) {
+                fft_len <<= 1;
+            }
+        }
+    }
+    if (fft_len <= kernlen) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    esp_err_t result = dsps_rfft_plan_init_fc32(&conv->plan, fft_len);
+    if (result != ESP_OK) {
+        return result;
+    }
+    int block = fft_len - kernlen + 1;
+    int total = 2 * DSP_BLOCK_BUFF_SIZE(fft_len + 2) + DSP_BLOCK_BUFF_SIZE(fft_len) + DSP_BLOCK_BUFF_SIZE(block);
+    float *mem = (float *)memalign(16, total * sizeof(float));
+    if (mem == NULL) {
+        dsps_rfft_plan_free(&conv->plan);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    memset(mem, 0, total * sizeof(float));
+    conv->kernel_fft = dsp_block_buff_carve(&mem, fft_len + 2);
+    conv->work = dsp_block_buff_carve(&mem, fft_len + 2);
+    conv->in_buff = dsp_block_buff_carve(&mem, fft_len);
+    conv->out_buff = dsp_block_buff_carve(&mem, block);
+    conv->kernlen = kernlen;
+    conv->block = block;
+    conv->fft_len = fft_len;
+
+    for (int i = 0; i < kernlen; i++) {
+        conv->kernel_fft[i] = reverse ? kernel[kernlen - 1 - i] : kernel[i];
+    }
+    result = dsps_rfft_fc32(&conv->plan, conv->kernel_fft);
+    if (result != ESP_OK) {
+        dsps_conv_fft_free(conv);
+    }
+    return result;
+}
+
+esp_err_t dsps_conv_fft_init_f32(dsps_conv_fft_t *conv, const float *kernel, int kernlen, int fft_len)
+{
+    return dsps_conv_fft_init_(conv, kernel, kernlen, fft_len, 0);
+}
+
+esp_err_t dsps_corr_fft_init_f32(dsps_conv_fft_t *conv, const float *pattern, int patlen, int fft_len)
+{
+    return dsps_conv_fft_init_(conv, pattern, patlen, fft_len, 1);
+}
+
+void dsps_conv_fft_free(dsps_conv_fft_t *conv)
+{
+    dsps_rfft_plan_free(&conv->plan);
+    free(conv->kernel_fft);
+    memset(conv, 0, sizeof(dsps_conv_fft_t));
+}
+
+// Convolves the fft_len samples of in_buff with the kernel, the last block samples of the result go to out_buff
+static esp_err_t dsps_conv_fft_block(dsps_conv_fft_t *conv)
+{
+    int N = conv->fft_len;
+    float *work = conv->work;
+    const float *kernel_fft = conv->kernel_fft;
+    memcpy(work, conv->in_buff, N * sizeof(float));
+    esp_err_t result = dsps_rfft_fc32(&conv->plan, work);
+    if (result != ESP_OK) {
+        return result;
+    }
+    // Im[0] and Im[N/2] are 0, so the DC and Nyquist bins are multiplied as complex values too
+    for (int k = 0; k <= N / 2; k++) {
+        float re = work[2 * k + 0] * kernel_fft[2 * k + 0] - work[2 * k + 1] * kernel_fft[2 * k + 1];
+        float im = work[2 * k + 0] * kernel_fft[2 * k + 1] + work[2 * k + 1] * kernel_fft[2 * k + 0];
+        work[2 * k + 0] = re;
+        work[2 * k + 1] = im;
+    }
+    result = dsps_irfft_fc32(&conv->plan, work);
+    if (result != ESP_OK) {
+        return result;
+    }
+    // The first kernlen - 1 samples are circular aliases and are discarded
+    memcpy(conv->out_buff, &work[conv->kernlen - 1], conv->block * sizeof(float));
+    return ESP_OK;
+}
+
+// Convolves the complete block and keeps the last kernlen - 1 input samples as the history of the next one
+static esp_err_t dsps_conv_fft_stream_block(void *arg)
+{
+    dsps_conv_fft_t *conv = (dsps_conv_fft_t *)arg;
+    esp_err_t result = dsps_conv_fft_block(conv);
+    memmove(conv->in_buff, &conv->in_buff[conv->block], (conv->kernlen - 1) * sizeof(float));
+    return result;
+}
+
+esp_err_t dsps_conv_fft_process_f32(dsps_conv_fft_t *conv, const float *input, float *output, int len)
+{
+    if (conv->in_buff == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    // The block follows the history in in_buff
+    return dsp_block_buff_stream(input, output, len, &conv->in_buff[conv->kernlen - 1], conv->out_buff,
+                                 conv->block, &conv->pos, dsps_conv_fft_stream_block, conv);
+}
+
+// Calculates count samples of the full convolution of Signal and Kernel, starting from sample first
+static esp_err_t dsps_conv_fft_run(const float *Signal, int siglen, const float *Kernel, int kernlen, int reverse,
+                                   int fft_len, int first, int count, float *output)
+{
+    dsps_conv_fft_t conv;
+    esp_err_t result = dsps_conv_fft_init_(&conv, Kernel, kernlen, fft_len, reverse);
+    if (result != ESP_OK) {
+        return result;
+    }
+    int hist = kernlen - 1;
+    for (int n = first; n < first + count; n += conv.block) {
+        // in_buff[i] = Signal[n - hist + i], zero outside of the signal
+        int start = n - hist;
+        int lo = start < 0 ? -start : 0;
+        int hi = siglen - start;
+        if (hi > fft_len) {
+            hi = fft_len;
+        }
+        memset(conv.in_buff, 0, fft_len * sizeof(float));
+        if (hi > lo) {
+            memcpy(&conv.in_buff[lo], &Signal[start + lo], (hi - lo) * sizeof(float));
+        }
+        result = dsps_conv_fft_block(&conv);
+        if (result != ESP_OK) {
+            break;
+        }
+        int out_len = first + count - n;
+        if (out_len > conv.block) {
+            out_len = conv.block;
+        }
+        memcpy(&output[n - first], conv.out_buff, out_len * sizeof(float));
+    }
+    dsps_conv_fft_free(&conv);
+    return result;
+}
+
+esp_err_t dsps_conv_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *convout)
+{
+    if ((NULL == Signal) || (NULL == Kernel) || (NULL == convout) || (siglen <= 0) || (kernlen <= 0)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    // The convolution is commutative, the shorter array is the kernel
+    const float *sig = Signal;
+    const float *kern = Kernel;
+    int lsig = siglen;
+    int lkern = kernlen;
+    if (siglen < kernlen) {
+        sig = Kernel;
+        kern = Signal;
+        lsig = kernlen;
+        lkern = siglen;
+    }
+    int fft_len = dsps_conv_fft_len(lkern, lsig + lkern - 1);
+    if (fft_len == 0) {
+        return dsps_conv_f32(Signal, siglen, Kernel, kernlen, convout);
+    }
+    return dsps_conv_fft_run(sig, lsig, kern, lkern, 0, fft_len, 0, lsig + lkern - 1, convout);
+}
+
+esp_err_t dsps_corr_fft_f32(const float *Signal, const int siglen, const float *Pattern, const int patlen, float *dest)
+{
+    if ((NULL == Signal) || (NULL == Pattern) || (NULL == dest) || (patlen <= 0) || (siglen < patlen)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    int fft_len = dsps_conv_fft_len(patlen, siglen - patlen + 1);
+    if (fft_len == 0) {
+        return dsps_corr_f32(Signal, siglen, Pattern, patlen, dest);
+    }
+    // dest[n] is sample n + patlen - 1 of the convolution with the reversed pattern
+    return dsps_conv_fft_run(Signal, siglen, Pattern, patlen, 1, fft_len, patlen - 1, siglen - patlen + 1, dest);
+}
+
+esp_err_t dsps_ccorr_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *corrout)
+{
+    if ((NULL == Signal) || (NULL == Kernel) || (NULL == corrout) || (siglen <= 0) || (kernlen <= 0)) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    // The shorter array is reversed, the same as dsps_ccorr_f32() does
+    const float *sig = Signal;
+    const float *kern = Kernel;
+    int lsig = siglen;
+    int lkern = kernlen;
+    if (siglen < kernlen) {
+        sig = Kernel;
+        kern = Signal;
+        lsig = kernlen;
+        lkern = siglen;
+    }
+    int fft_len = dsps_conv_fft_len(lkern, lsig + lkern - 1);
+    if (fft_len == 0) {
+        return dsps_ccorr_f32(Signal, siglen, Kernel, kernlen, corrout);
+    }
+    return dsps_conv_fft_run(sig, lsig, kern, lkern, 1, fft_len, 0, lsig + lkern - 1, corrout);
+}
@@ -0,0 +1,187 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsps_conv_fft_H_
+#define _dsps_conv_fft_H_
+
+#include "dsp_err.h"
+#include "sdkconfig.h"
+#include "dsps_rfft.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Kernels shorter than this are always convolved directly
+#define DSPS_CONV_FFT_MIN_KERNEL 32
+// Largest FFT length selected by dsps_conv_fft_len()
+#define DSPS_CONV_FFT_MAX_LEN 8192
+
+/**
+ * @brief Data struct of the overlap-save FFT convolution
+ *
+ * The input is processed in blocks of (fft_len - kernlen + 1) samples. Every block, together with
+ * the last (kernlen - 1) samples of the previous blocks, is transformed with the real FFT,
+ * multiplied by the precomputed spectrum of the kernel and transformed back.
+ * The cost per output sample grows with log2(fft_len) instead of kernlen.
+ * A user should access this structure only in case of extensions for the DSP Library.
+ * To initialize the structure, use the dsps_conv_fft_init_f32() or dsps_corr_fft_init_f32() function.
+ * To process the stream, use the dsps_conv_fft_process_f32() function.
+ * To free the structure, use the dsps_conv_fft_free() function.
+ */
+typedef struct dsps_conv_fft_s {
+    dsps_rfft_plan_t plan;      /*!< Real FFT plan of fft_len samples.*/
+    float  *kernel_fft;         /*!< Spectrum of the kernel, fft_len + 2 values.*/
+    float  *in_buff;            /*!< Input history and current block, fft_len samples.*/
+    float  *out_buff;           /*!< Output of the previous block, block samples.*/
+    float  *work;               /*!< FFT buffer, fft_len + 2 values.*/
+    int     kernlen;            /*!< Length of the kernel.*/
+    int     block;              /*!< Number of samples per block, fft_len - kernlen + 1.*/
+    int     fft_len;            /*!< Length of the FFT.*/
+    int     pos;                /*!< Number of samples of the current block.*/
+} dsps_conv_fft_t;
+
+/**
+ * @brief   FFT length for the overlap-save convolution
+ *
+ * Estimates the cost of the direct convolution and of the overlap-save convolution
+ * for every power of two FFT length up to DSPS_CONV_FFT_MAX_LEN, and returns the cheapest one.
+ *
+ * @param kernlen: length of the kernel
+ * @param outlen: number of output samples
+ *
+ * @return
+ *      - FFT length, if the overlap-save convolution is faster
+ *      - 0, if the direct convolution is faster
+ */
+int dsps_conv_fft_len(int kernlen, int outlen);
+
+/**
+ * @brief   initialize streaming FFT convolution
+ *
+ * The output of dsps_conv_fft_process_f32() is the input convolved with the kernel.
+ * The kernel is copied, so the array could be released after the call.
+ *
+ * @param conv: pointer to the convolution structure, that must be preallocated
+ * @param[in] kernel: array with kernel values
+ * @param kernlen: length of the kernel
+ * @param fft_len: FFT length, power of two, bigger than kernlen.
+ *                 If 0, the length with the lowest cost per sample is selected.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if kernlen or fft_len is not valid
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if memory allocation fails
+ */
+esp_err_t dsps_conv_fft_init_f32(dsps_conv_fft_t *conv, const float *kernel, int kernlen, int fft_len);
+
+/**
+ * @brief   initialize streaming FFT correlation
+ *
+ * Matched filter: the output of dsps_conv_fft_process_f32() is the correlation of the input
+ * with the pattern, as dsps_corr_f32() calculates it over the last patlen input samples.
+ * The pattern is copied, so the array could be released after the call.
+ *
+ * @param conv: pointer to the convolution structure, that must be preallocated
+ * @param[in] pattern: array with pattern values
+ * @param patlen: length of the pattern
+ * @param fft_len: FFT length, power of two, bigger than patlen.
+ *                 If 0, the length with the lowest cost per sample is selected.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if patlen or fft_len is not valid
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if memory allocation fails
+ */
+esp_err_t dsps_corr_fft_init_f32(dsps_conv_fft_t *conv, const float *pattern, int patlen, int fft_len);
+
+/**
+ * @brief   free streaming FFT convolution
+ *
+ * @param conv: pointer to the convolution structure
+ */
+void dsps_conv_fft_free(dsps_conv_fft_t *conv);
+
+/**
+ * @brief   streaming FFT convolution
+ *
+ * Processes any number of samples. The output is delayed by conv->block samples:
+ * output sample n is the convolution at input sample n - conv->block, the first
+ * conv->block output samples after the init are 0.
+ * The input and output arrays could be the same.
+ *
+ * @param conv: initialized convolution structure
+ * @param[in] input: input samples
+ * @param[out] output: output samples
+ * @param len: number of input and output samples
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the structure is not initialized
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_conv_fft_process_f32(dsps_conv_fft_t *conv, const float *input, float *output, int len);
+
+/**
+ * @brief   Convolution with automatic selection of the method
+ *
+ * The same as dsps_conv_f32(). For long kernels the overlap-save FFT convolution is used,
+ * otherwise the direct convolution. The selection is done by dsps_conv_fft_len().
+ *
+ * @param[in] Signal:  input array with signal
+ * @param[in] siglen:  length of the input signal
+ * @param[in] Kernel:  input array with convolution kernel
+ * @param[in] kernlen: length of the Kernel array
+ * @param convout: output array with convolution result length of (siglen + Kernel -1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_conv_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *convout);
+
+/**
+ * @brief   Correlation with automatic selection of the method
+ *
+ * The same as dsps_corr_f32(). For long patterns the overlap-save FFT correlation is used,
+ * otherwise the direct correlation. The selection is done by dsps_conv_fft_len().
+ *
+ * @param[in] Signal: input array with signal values
+ * @param[in] siglen: length of the signal array
+ * @param[in] Pattern: input array with pattern values
+ * @param[in] patlen: length of the pattern array. The siglen must be bigger then patlen!
+ * @param dest: output array with result of correlation, length of (siglen - patlen + 1)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library (one of the input array are NULL, or if (siglen < patlen))
+ */
+esp_err_t dsps_corr_fft_f32(const float *Signal, const int siglen, const float *Pattern, const int patlen, float *dest);
+
+/**
+ * @brief   Cross correlation with automatic selection of the method
+ *
+ * The same as dsps_ccorr_f32(). For long signals the overlap-save FFT correlation is used,
+ * otherwise the direct correlation. The selection is done by dsps_conv_fft_len().
+ *
+ * @param[in] Signal: input array with input 1 signal values
+ * @param[in] siglen: length of the input 1 signal array
+ * @param[in] Kernel: input array with input 2 signal values
+ * @param[in] kernlen: length of the input 2 signal array
+ * @param corrout: output array with result of cross correlation. The size of dest array must be (siglen + kernlen - 1) !!!
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_ccorr_fft_f32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *corrout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_conv_fft_H_
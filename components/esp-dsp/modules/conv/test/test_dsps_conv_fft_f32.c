@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <malloc.h>
+#include "unity.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "esp_dsp.h"
+#include "dsps_conv_fft.h"
+#include "dsps_ccorr.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_conv_fft";
+
+#define CONV_FFT_MAX_LEN 3000
+
+static void fill_random(float *data, int len)
+{
+    for (int i = 0 ; i < len ; i++) {
+        data[i] = (float)rand() / (float)RAND_MAX - 0.5f;
+    }
+}
+
+static float max_error(const float *result, const float *expected, int len)
+{
+    float max_err = 0;
+    for (int i = 0 ; i < len ; i++) {
+        max_err = fmaxf(max_err, fabsf(result[i] - expected[i]));
+    }
+    return max_err;
+}
+
+TEST_CASE("dsps_conv_fft_f32 functionality", "[dsps]")
+{
+    float *x = (float *)malloc(CONV_FFT_MAX_LEN * sizeof(float));
+    float *y = (float *)malloc(CONV_FFT_MAX_LEN * sizeof(float));
+    float *result = (float *)malloc(2 * CONV_FFT_MAX_LEN * sizeof(float));
+    float *expected = (float *)malloc(2 * CONV_FFT_MAX_LEN * sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_NOT_NULL(expected);
+
+    // Signal and kernel lengths, the short ones are convolved directly
+    const int sizes[][2] = {{1000, 300}, {300, 1000}, {3000, 64}, {2000, 1999}, {50, 40}, {200, 8}};
+    for (int s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+        int la = sizes[s][0];
+        int lb = sizes[s][1];
+        fill_random(x, la);
+        fill_random(y, lb);
+        int fft_len = dsps_conv_fft_len(la < lb ? la : lb, la + lb - 1);
+        // Rounding error grows with the number of summed products
+        float tol = 2e-6f * (la < lb ? la : lb) + 1e-5f;
+
+        TEST_ESP_OK(dsps_conv_fft_f32(x, la, y, lb, result));
+        TEST_ESP_OK(dsps_conv_f32_ansi(x, la, y, lb, expected));
+        float err_conv = max_error(result, expected, la + lb - 1);
+
+        TEST_ESP_OK(dsps_ccorr_fft_f32(x, la, y, lb, result));
+        TEST_ESP_OK(dsps_ccorr_f32_ansi(x, la, y, lb, expected));
+        float err_ccorr = max_error(result, expected, la + lb - 1);
+
+        float err_corr = 0;
+        if (la >= lb) {
+            TEST_ESP_OK(dsps_corr_fft_f32(x, la, y, lb, result));
+            TEST_ESP_OK(dsps_corr_f32_ansi(x, la, y, lb, expected));
+            err_corr = max_error(result, expected, la - lb + 1);
+        }
+        ESP_LOGI(TAG, "siglen %4i, kernlen %4i, fft_len %4i: max error conv %e, ccorr %e, corr %e",
+                 la, lb, fft_len, err_conv, err_ccorr, err_corr);
+        if ((err_conv > tol) || (err_ccorr > tol) || (err_corr > tol)) {
+            TEST_ASSERT_MESSAGE(false, "Result out of range!");
+        }
+    }
+    TEST_ASSERT_EQUAL(0, dsps_conv_fft_len(DSPS_CONV_FFT_MIN_KERNEL - 1, 100000));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_corr_fft_f32(x, 100, y, 200, result));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_PARAM_OUTOFRANGE, dsps_conv_fft_f32(NULL, 100, y, 200, result));
+
+    free(x);
+    free(y);
+    free(result);
+    free(expected);
+}
+
+TEST_CASE("dsps_conv_fft_process_f32 functionality", "[dsps]")
+{
+    const int len = CONV_FFT_MAX_LEN;
+    const int kernlen = 257;
+    float *x = (float *)malloc(len * sizeof(float));
+    float *h = (float *)malloc(kernlen * sizeof(float));
+    float *result = (float *)malloc(len * sizeof(float));
+    float *expected = (float *)malloc((len + kernlen) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(h);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_NOT_NULL(expected);
+    fill_random(x, len);
+    fill_random(h, kernlen);
+
+    // Convolution and matched filter, with the selected and with a fixed FFT length
+    const int configs[][2] = {{0, 0}, {512, 0}, {0, 1}, {1024, 1}};
+    for (int c = 0 ; c < sizeof(configs) / sizeof(configs[0]) ; c++) {
+        int correlation = configs[c][1];
+        dsps_conv_fft_t conv;
+        if (correlation) {
+            TEST_ESP_OK(dsps_corr_fft_init_f32(&conv, h, kernlen, configs[c][0]));
+            TEST_ESP_OK(dsps_ccorr_f32_ansi(x, len, h, kernlen, expected));
+        } else {
+            TEST_ESP_OK(dsps_conv_fft_init_f32(&conv, h, kernlen, configs[c][0]));
+            TEST_ESP_OK(dsps_conv_f32_ansi(x, len, h, kernlen, expected));
+        }
+        // Chunks of different sizes, processed in place
+        memcpy(result, x, len * sizeof(float));
+        for (int pos = 0, chunk = 1 ; pos < len ; pos += chunk, chunk = chunk * 3 + 1) {
+            if (chunk > len - pos) {
+                chunk = len - pos;
+            }
+            TEST_ESP_OK(dsps_conv_fft_process_f32(&conv, &result[pos], &result[pos], chunk));
+        }
+        float max_err = 0;
+        for (int i = 0 ; i < len ; i++) {
+            float ref = (i < conv.block) ? 0 : expected[i - conv.block];
+            max_err = fmaxf(max_err, fabsf(result[i] - ref));
+        }
+        ESP_LOGI(TAG, "%s fft_len %i, block %i, max error %e", correlation ? "correlation" : "convolution",
+                 conv.fft_len, conv.block, max_err);
+        if (max_err > 1e-3) {
+            TEST_ASSERT_MESSAGE(false, "Result out of range!");
+        }
+        dsps_conv_fft_free(&conv);
+        TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_conv_fft_process_f32(&conv, x, result, 1));
+    }
+
+    dsps_conv_fft_t conv;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_conv_fft_init_f32(&conv, h, kernlen, 256));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_conv_fft_init_f32(&conv, h, kernlen, 1000));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_conv_fft_init_f32(&conv, h, 0, 512));
+
+    free(x);
+    free(h);
+    free(result);
+    free(expected);
+}
+
+TEST_CASE("dsps_conv_fft_f32 benchmark", "[dsps]")
+{
+    const int siglen = 1024;
+    const int kernlen = 256;
+    float *x = (float *)malloc(siglen * sizeof(float));
+    float *h = (float *)malloc(kernlen * sizeof(float));
+    float *z = (float *)malloc((siglen + kernlen) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(h);
+    TEST_ASSERT_NOT_NULL(z);
+    fill_random(x, siglen);
+    fill_random(h, kernlen);
+
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_conv_f32(x, siglen, h, kernlen, z);
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    int cycles_direct = end_b - start_b;
+
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_conv_fft_f32(x, siglen, h, kernlen, z);
+    end_b = dsp_get_cpu_cycle_count();
+    int cycles_fft = end_b - start_b;
+
+    dsps_conv_fft_t conv;
+    TEST_ESP_OK(dsps_conv_fft_init_f32(&conv, h, kernlen, 512));
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_conv_fft_process_f32(&conv, x, z, siglen);
+    end_b = dsp_get_cpu_cycle_count();
+    int cycles_stream = end_b - start_b;
+
+    ESP_LOGI(TAG, "Benchmark signal %i, kernel %i: dsps_conv_f32 %i, dsps_conv_fft_f32 %i cycles, streaming fft_len %i: %i cycles per sample",
+             siglen, kernlen, cycles_direct, cycles_fft, conv.fft_len, cycles_stream / siglen);
+    TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_fft);
+    dsps_conv_fft_free(&conv);
+    free(x);
+    free(h);
+    free(z);
+}
@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+#include <stdlib.h>
+
+unsigned short reverse(unsigned short x, unsigned short N, int order);
+
+// The butterfly output is at most (1 + sqrt(2)) times larger than its input,
+// a stage with the input up to this limit could not overflow
+#define DSPS_BFP_SC16_LIMIT 13572
+
+static int dsps_bfp_sc16_max(const int16_t *data, int len)
+{
+    int max = 0;
+    for (int i = 0; i < len; i++) {
+        int val = abs(data[i]);
+        if (val > max) {
+            max = val;
+        }
+    }
+    return max;
+}
+
+esp_err_t dsps_fft2r_bfp_sc16_ansi_(int16_t *data, int N, int16_t *sc_table, int *exponent)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_sc16_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    *exponent = 0;
+    int max = dsps_bfp_sc16_max(data, N * 2);
+    if (max == 0) {
+        return ESP_OK;
+    }
+    // Normalize the input to use the full range
+    int exp = 0;
+    while ((max << 1) <= DSPS_BFP_SC16_LIMIT) {
+        max <<= 1;
+        exp--;
+    }
+    if (exp < 0) {
+        int mult = 1 << -exp;
+        for (int i = 0; i < N * 2; i++) {
+            data[i] = data[i] * mult;
+        }
+    }
+
+    sc16_t *w = (sc16_t *)sc_table;
+    sc16_t *in_data = (sc16_t *)data;
+    int ie = 1;
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        int shift = 0;
+        if (max > DSPS_BFP_SC16_LIMIT) {
+            shift = (max > 2 * DSPS_BFP_SC16_LIMIT) ? 2 : 1;
+        }
+        int round = (1 << shift) >> 1;
+        exp += shift;
+        max = 0;
+
+        int ia = 0;
+        for (int j = 0; j < ie; j++) {
+            int c = w[j].re;
+            int s = w[j].im;
+            for (int i = 0; i < N2; i++) {
+                int m = ia + N2;
+                sc16_t a_data = in_data[ia];
+                sc16_t m_data = in_data[m];
+                // temp = m_data * conj(w)
+                int re_temp = (c * m_data.re + s * m_data.im + 0x4000) >> 15;
+                int im_temp = (c * m_data.im - s * m_data.re + 0x4000) >> 15;
+
+                int re_m = (a_data.re - re_temp + round) >> shift;
+                int im_m = (a_data.im - im_temp + round) >> shift;
+                int re_a = (a_data.re + re_temp + round) >> shift;
+                int im_a = (a_data.im + im_temp + round) >> shift;
+                in_data[m].re = re_m;
+                in_data[m].im = im_m;
+                in_data[ia].re = re_a;
+                in_data[ia].im = im_a;
+
+                int stage_max = abs(re_m) | abs(im_m) | abs(re_a) | abs(im_a);
+                if (stage_max > max) {
+                    max = stage_max;
+                }
+                ia++;
+            }
+            ia += N2;
+        }
+        ie <<= 1;
+        // The OR above gives an upper bound, the exact maximum is needed only when the next stage has to scale
+        if (max > DSPS_BFP_SC16_LIMIT) {
+            max = dsps_bfp_sc16_max(data, N * 2);
+        }
+    }
+    *exponent = exp;
+    return ESP_OK;
+}
+
+esp_err_t dsps_rfft_bfp_sc16_ansi_(int16_t *data, int N, int16_t *sc_table, int *exponent)
+{
+    if ((N < 4) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int M = N >> 1;
+    esp_err_t result = dsps_fft2r_bfp_sc16_ansi_(data, M, sc_table, exponent);
+    if (result != ESP_OK) {
+        return result;
+    }
+    dsps_bit_rev_sc16_ansi(data, M);
+
+    // The split step output is up to (2 + 2*sqrt(2)) times larger than its input,
+    // and the result of the original formula is the half of it
+    int max = dsps_bfp_sc16_max(data, N);
+    int shift = 1;
+    while ((shift < 4) && (max > ((DSPS_BFP_SC16_LIMIT << shift) >> 2))) {
+        shift++;
+    }
+    int round = (1 << shift) >> 1;
+    *exponent += shift - 1;
+
+    sc16_t *table = (sc16_t *)sc_table;
+    sc16_t *result_data = (sc16_t *)data;
+    int order = dsp_power_of_two(M);
+
+    int re0 = result_data[0].re;
+    int im0 = result_data[0].im;
+    result_data[0].re = (re0 + im0 + (round >> 1)) >> (shift - 1);
+    result_data[0].im = 0;
+    result_data[M].re = (re0 - im0 + (round >> 1)) >> (shift - 1);
+    result_data[M].im = 0;
+
+    for (int k = 1; k <= M / 2; k++) {
+        sc16_t fpk = result_data[k];
+        sc16_t fpnk = result_data[M - k];
+        int f1k_re = fpk.re + fpnk.re;
+        int f1k_im = fpk.im - fpnk.im;
+        int f2k_re = fpk.re - fpnk.re;
+        int f2k_im = fpk.im + fpnk.im;
+
+        // Table entry of exp(i*pi*k/M), with c = -sin, s = -cos as in dsps_cplx2real_fc32_ansi_
+        sc16_t w = table[reverse(k, M, order)];
+        int c = -w.im;
+        int s = -w.re;
+        // Every product is rounded separately, the sum of two products could overflow int32
+        int tw_re = ((c * f2k_re + 0x4000) >> 15) - ((s * f2k_im + 0x4000) >> 15);
+        int tw_im = ((s * f2k_re + 0x4000) >> 15) + ((c * f2k_im + 0x4000) >> 15);
+
+        result_data[k].re = (f1k_re + tw_re + round) >> shift;
+        result_data[k].im = (f1k_im + tw_im + round) >> shift;
+        result_data[M - k].re = (f1k_re - tw_re + round) >> shift;
+        result_data[M - k].im = (tw_im - f1k_im + round) >> shift;
+    }
+    return ESP_OK;
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dsps_fft2r.h"
+#include "dsps_fft_plan.h"
 #include "dsp_common.h"
 #include "dsp_types.h"
 #include <math.h>
@@ -31,6 +32,9 @@ uint8_t dsps_fft2r_mem_allocated = 0;
 
 uint16_t *dsps_fft2r_ram_rev_table = NULL;
 
+// Tables behind dsps_fft_w_table_fc32. Use dsps_fft_plan_init_fc32() directly to have more than one size.
+static dsps_fft_plan_t dsps_fft2r_plan_fc32;
+
 #ifdef CONFIG_IDF_TARGET_ESP32S3
 extern float *dsps_fft2r_w_table_fc32_1024;
 #endif // CONFIG_IDF_TARGET_ESP32S3
@@ -49,51 +53,29 @@ esp_err_t dsps_fft2r_init_fc32(float *fft_table_buff, int table_size)
     if (table_size == 0) {
         return result;
     }
-    if (fft_table_buff != NULL) {
-        if (dsps_fft2r_mem_allocated) {
-            return ESP_ERR_DSP_REINITIALIZED;
-        }
-        dsps_fft_w_table_fc32 = fft_table_buff;
-        dsps_fft_w_table_size = table_size;
-    } else {
-        if (!dsps_fft2r_mem_allocated) {
+    if ((fft_table_buff != NULL) && dsps_fft2r_mem_allocated) {
+        return ESP_ERR_DSP_REINITIALIZED;
+    }
+    float *w_buff = fft_table_buff;
 #if CONFIG_IDF_TARGET_ESP32S3
-            if (table_size <= 1024) {
-                dsps_fft_w_table_fc32 = dsps_fft2r_w_table_fc32_1024;
-            } else {
-                dsps_fft_w_table_fc32 = (float *)memalign(16, sizeof(float) * table_size);
-            }
-#else
-            dsps_fft_w_table_fc32 = (float *)malloc(table_size * sizeof(float));
+    if ((w_buff == NULL) && (table_size <= 1024)) {
+        w_buff = dsps_fft2r_w_table_fc32_1024;
+    }
 #endif
-            if (dsps_fft_w_table_fc32 == NULL) {
-                return ESP_ERR_DSP_PARAM_OUTOFRANGE;
-            }
-        }
-        dsps_fft_w_table_size = table_size;
-        dsps_fft2r_mem_allocated = 1;
-
+    result = dsps_fft_plan_init_fc32(&dsps_fft2r_plan_fc32, table_size, 2, w_buff);
+    if (result != ESP_OK) {
+        return result;
     }
+    dsps_fft_w_table_fc32 = dsps_fft2r_plan_fc32.w;
+    dsps_fft_w_table_size = table_size;
+    dsps_fft2r_mem_allocated = (fft_table_buff == NULL);
 
-    // FFT ram_rev table allocated
+    // The bit reverse table of the plan is in RAM, dsps_bit_rev2r_fc32() uses it for this size
     int pow = dsp_power_of_two(table_size);
     if ((pow > 3) && (pow < 13)) {
-        dsps_fft2r_ram_rev_table = (uint16_t *)malloc(2 * dsps_fft2r_rev_tables_fc32_size[pow - 4] * sizeof(uint16_t));
-        if (dsps_fft2r_ram_rev_table == NULL) {
-            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
-        }
-        memcpy(dsps_fft2r_ram_rev_table, dsps_fft2r_rev_tables_fc32[pow - 4], 2 * dsps_fft2r_rev_tables_fc32_size[pow - 4] * sizeof(uint16_t));
+        dsps_fft2r_ram_rev_table = dsps_fft2r_plan_fc32.rev_table;
         dsps_fft2r_rev_tables_fc32[pow - 4] = dsps_fft2r_ram_rev_table;
     }
-
-    result = dsps_gen_w_r2_fc32(dsps_fft_w_table_fc32, dsps_fft_w_table_size);
-    if (result != ESP_OK) {
-        return result;
-    }
-    result = dsps_bit_rev_fc32_ansi(dsps_fft_w_table_fc32, dsps_fft_w_table_size >> 1);
-    if (result != ESP_OK) {
-        return result;
-    }
     dsps_fft2r_initialized = 1;
 
     return ESP_OK;
@@ -101,19 +83,9 @@ esp_err_t dsps_fft2r_init_fc32(float *fft_table_buff, int table_size)
 
 void dsps_fft2r_deinit_fc32()
 {
-    if (dsps_fft2r_mem_allocated) {
-#if CONFIG_IDF_TARGET_ESP32S3
-        if (dsps_fft_w_table_fc32 != dsps_fft2r_w_table_fc32_1024) {
-            free(dsps_fft_w_table_fc32);
-        }
-#else
-        free(dsps_fft_w_table_fc32);
-#endif
-    }
-    if (dsps_fft2r_ram_rev_table != NULL) {
-        free(dsps_fft2r_ram_rev_table);
-        dsps_fft2r_ram_rev_table = NULL;
-    }
+    dsps_fft_plan_free(&dsps_fft2r_plan_fc32);
+    dsps_fft2r_ram_rev_table = NULL;
+    dsps_fft_w_table_fc32 = NULL;
     // Re init bitrev table for next use
     dsps_fft2r_rev_tables_init_fc32();
     dsps_fft2r_mem_allocated = 0;
@@ -125,7 +97,7 @@ esp_err_t dsps_fft2r_fc32_ansi_(float *data, int N, float *w)
     if (!dsp_is_power_of_two(N)) {
         return ESP_ERR_DSP_INVALID_LENGTH;
     }
-    if (!dsps_fft2r_initialized) {
+    if (w == NULL) {
         return ESP_ERR_DSP_UNINITIALIZED;
     }
 
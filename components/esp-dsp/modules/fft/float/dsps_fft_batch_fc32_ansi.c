@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_fft_plan.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+
+esp_err_t dsps_fft2r_batch_fc32_ansi_(float *data, int N, float *w, int frames, int frame_step, int elem_step)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    fc32_t *cplx = (fc32_t *)data;
+    int ie = 1;
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        int ia = 0;
+        for (int j = 0; j < ie; j++) {
+            float c = w[2 * j];
+            float s = w[2 * j + 1];
+            for (int i = 0; i < N2; i++) {
+                fc32_t *pa = &cplx[ia * elem_step];
+                fc32_t *pm = &cplx[(ia + N2) * elem_step];
+                for (int k = 0; k < frames; k++) {
+                    fc32_t a = *pa;
+                    fc32_t m = *pm;
+                    float re_temp = c * m.re + s * m.im;
+                    float im_temp = c * m.im - s * m.re;
+                    pm->re = a.re - re_temp;
+                    pm->im = a.im - im_temp;
+                    pa->re = a.re + re_temp;
+                    pa->im = a.im + im_temp;
+                    pa += frame_step;
+                    pm += frame_step;
+                }
+                ia++;
+            }
+            ia += N2;
+        }
+        ie <<= 1;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft4r_batch_fc32_ansi_(float *data, int N, float *table, int table_size, int frames, int frame_step, int elem_step)
+{
+    if (NULL == table) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int log2N = dsp_power_of_two(N);
+    int log4N = log2N >> 1;
+    if ((log2N & 0x01) != 0) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+
+    fc32_t *cplx = (fc32_t *)data;
+    int length = N;
+    int m = 2;
+    int wind_step = table_size / N;
+    for (; log4N > 0; log4N--) {
+        length = length >> 2;
+        for (int j = 0; j < m; j += 2) {
+            int start_index = j * (length << 1);
+            fc32_t *winc0 = (fc32_t *)table;
+            fc32_t *winc1 = winc0;
+            fc32_t *winc2 = winc0;
+
+            for (int n = 0; n < length; n++) {
+                fc32_t w0 = *winc0;
+                fc32_t w1 = *winc1;
+                fc32_t w2 = *winc2;
+                fc32_t *ptrc0 = &cplx[(start_index + n) * elem_step];
+                fc32_t *ptrc1 = ptrc0 + length * elem_step;
+                fc32_t *ptrc2 = ptrc1 + length * elem_step;
+                fc32_t *ptrc3 = ptrc2 + length * elem_step;
+
+                for (int k = 0; k < frames; k++) {
+                    fc32_t in0 = *ptrc0;
+                    fc32_t in1 = *ptrc1;
+                    fc32_t in2 = *ptrc2;
+                    fc32_t in3 = *ptrc3;
+                    fc32_t bfly[4];
+
+                    bfly[0].re = in0.re + in2.re + in1.re + in3.re;
+                    bfly[0].im = in0.im + in2.im + in1.im + in3.im;
+
+                    bfly[1].re = in0.re - in2.re + in1.im - in3.im;
+                    bfly[1].im = in0.im - in2.im - in1.re + in3.re;
+
+                    bfly[2].re = in0.re + in2.re - in1.re - in3.re;
+                    bfly[2].im = in0.im + in2.im - in1.im - in3.im;
+
+                    bfly[3].re = in0.re - in2.re - in1.im + in3.im;
+                    bfly[3].im = in0.im - in2.im + in1.re - in3.re;
+
+                    *ptrc0 = bfly[0];
+                    ptrc1->re = bfly[1].re * w0.re + bfly[1].im * w0.im;
+                    ptrc1->im = bfly[1].im * w0.re - bfly[1].re * w0.im;
+                    ptrc2->re = bfly[2].re * w1.re + bfly[2].im * w1.im;
+                    ptrc2->im = bfly[2].im * w1.re - bfly[2].re * w1.im;
+                    ptrc3->re = bfly[3].re * w2.re + bfly[3].im * w2.im;
+                    ptrc3->im = bfly[3].im * w2.re - bfly[3].re * w2.im;
+
+                    ptrc0 += frame_step;
+                    ptrc1 += frame_step;
+                    ptrc2 += frame_step;
+                    ptrc3 += frame_step;
+                }
+                winc0 += 1 * wind_step;
+                winc1 += 2 * wind_step;
+                winc2 += 3 * wind_step;
+            }
+        }
+        m = m << 2;
+        wind_step = wind_step << 2;
+    }
+    return ESP_OK;
+}
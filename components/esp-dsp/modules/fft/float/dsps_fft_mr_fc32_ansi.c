@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_fft_mr.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+#include <math.h>
+#include <string.h>
+#include <malloc.h>
+
+// sin(2*pi/3), cos(2*pi/5), cos(4*pi/5), sin(2*pi/5), sin(4*pi/5)
+#define DSPS_FFT_MR_S3  0.866025403784439f
+#define DSPS_FFT_MR_C51 0.309016994374947f
+#define DSPS_FFT_MR_C52 -0.809016994374947f
+#define DSPS_FFT_MR_S51 0.951056516295154f
+#define DSPS_FFT_MR_S52 0.587785252292473f
+
+static inline fc32_t dsps_fft_mr_mul(fc32_t a, fc32_t b)
+{
+    fc32_t result;
+    result.re = a.re * b.re - a.im * b.im;
+    result.im = a.re * b.im + a.im * b.re;
+    return result;
+}
+
+esp_err_t dsps_fft_mr_plan_init_fc32(dsps_fft_mr_plan_t *plan, int N)
+{
+    memset(plan, 0, sizeof(dsps_fft_mr_plan_t));
+    if (N < 2) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int P = 1;
+    int n = N;
+    while ((n & 1) == 0) {
+        P <<= 1;
+        n >>= 1;
+    }
+    int count = 0;
+    while (n > 1) {
+        int p = 0;
+        if (n % 5 == 0) {
+            p = 5;
+        } else if (n % 3 == 0) {
+            p = 3;
+        }
+        if ((p == 0) || (count >= DSPS_FFT_MR_MAX_FACTORS)) {
+            return ESP_ERR_DSP_INVALID_LENGTH;
+        }
+        n /= p;
+        plan->factors[2 * count + 0] = p;
+        plan->factors[2 * count + 1] = n;
+        count++;
+    }
+    plan->N = N;
+    plan->P = P;
+    plan->Q = N / P;
+    plan->factors_count = count;
+
+    plan->w = (float *)memalign(16, 2 * N * sizeof(float));
+    plan->scratch = (float *)memalign(16, 2 * (N + plan->Q) * sizeof(float));
+    if ((plan->w == NULL) || (plan->scratch == NULL)) {
+        dsps_fft_mr_plan_free(plan);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    for (int k = 0; k < N; k++) {
+        float angle = 2 * M_PI * k / (float)N;
+        plan->w[2 * k + 0] = cosf(angle);
+        plan->w[2 * k + 1] = -sinf(angle);
+    }
+    if (P > 1) {
+        int radix = (dsp_power_of_two(P) & 1) ? 2 : 4;
+        esp_err_t result = dsps_fft_plan_init_fc32(&plan->fft, P, radix, NULL);
+        if (result != ESP_OK) {
+            dsps_fft_mr_plan_free(plan);
+            return result;
+        }
+    }
+    return ESP_OK;
+}
+
+void dsps_fft_mr_plan_free(dsps_fft_mr_plan_t *plan)
+{
+    dsps_fft_plan_free(&plan->fft);
+    free(plan->w);
+    free(plan->scratch);
+    memset(plan, 0, sizeof(dsps_fft_mr_plan_t));
+}
+
+static void dsps_fft_mr_bfly3(fc32_t *out, const fc32_t *w, int tw_step, int m)
+{
+    for (int k = 0; k < m; k++) {
+        fc32_t t0 = out[k];
+        fc32_t t1 = dsps_fft_mr_mul(out[k + m], w[k * tw_step]);
+        fc32_t t2 = dsps_fft_mr_mul(out[k + 2 * m], w[2 * k * tw_step]);
+        fc32_t s, d, a;
+        s.re = t1.re + t2.re;
+        s.im = t1.im + t2.im;
+        d.re = (t1.re - t2.re) * DSPS_FFT_MR_S3;
+        d.im = (t1.im - t2.im) * DSPS_FFT_MR_S3;
+        a.re = t0.re - 0.5f * s.re;
+        a.im = t0.im - 0.5f * s.im;
+
+        out[k].re = t0.re + s.re;
+        out[k].im = t0.im + s.im;
+        // y1 = a - i*d, y2 = a + i*d
+        out[k + m].re = a.re + d.im;
+        out[k + m].im = a.im - d.re;
+        out[k + 2 * m].re = a.re - d.im;
+        out[k + 2 * m].im = a.im + d.re;
+    }
+}
+
+static void dsps_fft_mr_bfly5(fc32_t *out, const fc32_t *w, int tw_step, int m)
+{
+    for (int k = 0; k < m; k++) {
+        fc32_t t0 = out[k];
+        fc32_t t1 = dsps_fft_mr_mul(out[k + m], w[k * tw_step]);
+        fc32_t t2 = dsps_fft_mr_mul(out[k + 2 * m], w[2 * k * tw_step]);
+        fc32_t t3 = dsps_fft_mr_mul(out[k + 3 * m], w[3 * k * tw_step]);
+        fc32_t t4 = dsps_fft_mr_mul(out[k + 4 * m], w[4 * k * tw_step]);
+
+        fc32_t s14, d14, s23, d23;
+        s14.re = t1.re + t4.re;
+        s14.im = t1.im + t4.im;
+        d14.re = t1.re - t4.re;
+        d14.im = t1.im - t4.im;
+        s23.re = t2.re + t3.re;
+        s23.im = t2.im + t3.im;
+        d23.re = t2.re - t3.re;
+        d23.im = t2.im - t3.im;
+
+        fc32_t a1, b1, a2, b2;
+        a1.re = t0.re + DSPS_FFT_MR_C51 * s14.re + DSPS_FFT_MR_C52 * s23.re;
+        a1.im = t0.im + DSPS_FFT_MR_C51 * s14.im + DSPS_FFT_MR_C52 * s23.im;
+        b1.re = DSPS_FFT_MR_S51 * d14.re + DSPS_FFT_MR_S52 * d23.re;
+        b1.im = DSPS_FFT_MR_S51 * d14.im + DSPS_FFT_MR_S52 * d23.im;
+        a2.re = t0.re + DSPS_FFT_MR_C52 * s14.re + DSPS_FFT_MR_C51 * s23.re;
+        a2.im = t0.im + DSPS_FFT_MR_C52 * s14.im + DSPS_FFT_MR_C51 * s23.im;
+        b2.re = DSPS_FFT_MR_S52 * d14.re - DSPS_FFT_MR_S51 * d23.re;
+        b2.im = DSPS_FFT_MR_S52 * d14.im - DSPS_FFT_MR_S51 * d23.im;
+
+        out[k].re = t0.re + s14.re + s23.re;
+        out[k].im = t0.im + s14.im + s23.im;
+        // y1 = a1 - i*b1, y4 = a1 + i*b1, y2 = a2 - i*b2, y3 = a2 + i*b2
+        out[k + m].re = a1.re + b1.im;
+        out[k + m].im = a1.im - b1.re;
+        out[k + 4 * m].re = a1.re - b1.im;
+        out[k + 4 * m].im = a1.im + b1.re;
+        out[k + 2 * m].re = a2.re + b2.im;
+        out[k + 2 * m].im = a2.im - b2.re;
+        out[k + 3 * m].re = a2.re - b2.im;
+        out[k + 3 * m].im = a2.im + b2.re;
+    }
+}
+
+// Decimation in time FFT of Q points: the input is read with a stride, the output is in natural order
+static void dsps_fft_mr_work(fc32_t *out, const fc32_t *in, int fstride, int in_stride, const int *factors, const fc32_t *w, int w_step)
+{
+    int p = factors[0];
+    int m = factors[1];
+    fc32_t *out_beg = out;
+    fc32_t *out_end = out + p * m;
+    if (m == 1) {
+        for (; out != out_end; out++) {
+            *out = *in;
+            in += fstride * in_stride;
+        }
+    } else {
+        for (; out != out_end; out += m) {
+            dsps_fft_mr_work(out, in, fstride * p, in_stride, factors + 2, w, w_step);
+            in += fstride * in_stride;
+        }
+    }
+    // Twiddles of the Q points FFT are every P-th entry of the N points table
+    if (p == 3) {
+        dsps_fft_mr_bfly3(out_beg, w, fstride * w_step, m);
+    } else {
+        dsps_fft_mr_bfly5(out_beg, w, fstride * w_step, m);
+    }
+}
+
+static esp_err_t dsps_fft_mr_fc32_(dsps_fft_mr_plan_t *plan, float *data, int optimized)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int P = plan->P;
+    int Q = plan->Q;
+    fc32_t *cplx = (fc32_t *)data;
+    fc32_t *y = (fc32_t *)plan->scratch;
+    fc32_t *tmp = y + plan->N;
+    const fc32_t *w = (const fc32_t *)plan->w;
+
+    // Q frames of P points: y[n2][n1] = x[Q*n1 + n2]
+    for (int n2 = 0; n2 < Q; n2++) {
+        for (int n1 = 0; n1 < P; n1++) {
+            y[n2 * P + n1] = cplx[Q * n1 + n2];
+        }
+    }
+    if (P > 1) {
+        esp_err_t result;
+        if (optimized) {
+            // The optimized kernels of the target, one frame at a time
+            result = ESP_OK;
+            for (int n2 = 0; (n2 < Q) && (result == ESP_OK); n2++) {
+                result = dsps_fft_plan_exec_fc32(&plan->fft, &plan->scratch[2 * n2 * P]);
+                if (result == ESP_OK) {
+                    result = dsps_fft_plan_bit_rev_fc32(&plan->fft, &plan->scratch[2 * n2 * P]);
+                }
+            }
+        } else {
+            if (plan->fft.radix == 4) {
+                result = dsps_fft4r_batch_fc32_ansi_(plan->scratch, P, plan->fft.w, plan->fft.w_size, Q, P, 1);
+            } else {
+                result = dsps_fft2r_batch_fc32_ansi_(plan->scratch, P, plan->fft.w, Q, P, 1);
+            }
+            for (int n2 = 0; (n2 < Q) && (result == ESP_OK); n2++) {
+                if (plan->fft.rev_table != NULL) {
+                    result = dsps_bit_rev_lookup_fc32_ansi(&plan->scratch[2 * n2 * P], plan->fft.rev_size, plan->fft.rev_table);
+                } else {
+                    result = dsps_fft_plan_bit_rev_fc32(&plan->fft, &plan->scratch[2 * n2 * P]);
+                }
+            }
+        }
+        if (result != ESP_OK) {
+            return result;
+        }
+    }
+    if (Q == 1) {
+        memcpy(data, plan->scratch, 2 * P * sizeof(float));
+        return ESP_OK;
+    }
+
+    // y[n2][k1] *= exp(-2*pi*i*n2*k1/N)
+    for (int n2 = 1; n2 < Q; n2++) {
+        for (int k1 = 1; k1 < P; k1++) {
+            y[n2 * P + k1] = dsps_fft_mr_mul(y[n2 * P + k1], w[n2 * k1]);
+        }
+    }
+    // P frames of Q points: X[k1 + P*k2]
+    for (int k1 = 0; k1 < P; k1++) {
+        dsps_fft_mr_work(tmp, &y[k1], 1, P, plan->factors, w, P);
+        for (int k2 = 0; k2 < Q; k2++) {
+            cplx[k1 + P * k2] = tmp[k2];
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft_mr_fc32_ansi(dsps_fft_mr_plan_t *plan, float *data)
+{
+    return dsps_fft_mr_fc32_(plan, data, 0);
+}
+
+esp_err_t dsps_fft_mr_fc32(dsps_fft_mr_plan_t *plan, float *data)
+{
+    return dsps_fft_mr_fc32_(plan, data, 1);
+}
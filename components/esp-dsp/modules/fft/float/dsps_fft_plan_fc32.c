@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_fft_plan.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+#include <math.h>
+#include <string.h>
+#include <malloc.h>
+
+// Kernels take the table as an argument, so the plan can use the optimized ones as well
+#if CONFIG_DSP_OPTIMIZED
+#if (dsps_fft2r_fc32_aes3_enabled == 1)
+#define dsps_fft_plan_r2_fc32(data, N, w, w_size) dsps_fft2r_fc32_aes3_(data, N, w)
+#elif (dsps_fft2r_fc32_ae32_enabled == 1)
+#define dsps_fft_plan_r2_fc32(data, N, w, w_size) dsps_fft2r_fc32_ae32_(data, N, w)
+#elif (dsps_fft2r_fc32_arp4_enabled == 1)
+#define dsps_fft_plan_r2_fc32(data, N, w, w_size) dsps_fft2r_fc32_arp4_(data, N, w)
+#else
+#define dsps_fft_plan_r2_fc32(data, N, w, w_size) dsps_fft2r_fc32_ansi_(data, N, w)
+#define dsps_fft_plan_r2_ansi 1
+#endif
+
+#if (dsps_fft4r_fc32_ae32_enabled == 1)
+#define dsps_fft_plan_r4_fc32(data, N, w, w_size) dsps_fft4r_fc32_ae32_(data, N, w, w_size)
+#elif (dsps_fft4r_fc32_aes3_enabled == 1)
+#define dsps_fft_plan_r4_fc32(data, N, w, w_size) dsps_fft4r_fc32_aes3_(data, N, w, w_size)
+#elif (dsps_fft4r_fc32_arp4_enabled == 1)
+#define dsps_fft_plan_r4_fc32(data, N, w, w_size) dsps_fft4r_fc32_arp4_(data, N, w, (w_size) / (N))
+#else
+#define dsps_fft_plan_r4_fc32(data, N, w, w_size) dsps_fft4r_fc32_ansi_(data, N, w, w_size)
+#define dsps_fft_plan_r4_ansi 1
+#endif
+#else // CONFIG_DSP_OPTIMIZED
+#define dsps_fft_plan_r2_fc32(data, N, w, w_size) dsps_fft2r_fc32_ansi_(data, N, w)
+#define dsps_fft_plan_r4_fc32(data, N, w, w_size) dsps_fft4r_fc32_ansi_(data, N, w, w_size)
+#define dsps_fft_plan_r2_ansi 1
+#define dsps_fft_plan_r4_ansi 1
+#endif // CONFIG_DSP_OPTIMIZED
+
+// Index pairs of the lookup table are byte offsets of complex floats, so they fit uint16_t up to 8192 points
+#define DSPS_FFT_PLAN_REV_TABLE_MAX_N 8192
+
+static int dsps_fft_plan_reverse(int i, int log2N, int radix)
+{
+    int bits = (radix == 4) ? 2 : 1;
+    int mask = radix - 1;
+    int result = 0;
+    for (int k = 0; k < log2N; k += bits) {
+        result = (result << bits) | (i & mask);
+        i >>= bits;
+    }
+    return result;
+}
+
+static esp_err_t dsps_fft_plan_gen_rev_table(dsps_fft_plan_t *plan, int log2N)
+{
+    int count = 0;
+    for (int i = 1; i < plan->N - 1; i++) {
+        if (i < dsps_fft_plan_reverse(i, log2N, plan->radix)) {
+            count++;
+        }
+    }
+    // The ae32 lookup swaps two pairs per iteration, an odd table is padded with a no-op pair
+    plan->rev_size = (count + 1) & ~1;
+    if (plan->rev_size == 0) {
+        return ESP_OK;
+    }
+    plan->rev_table = (uint16_t *)malloc(2 * plan->rev_size * sizeof(uint16_t));
+    if (plan->rev_table == NULL) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    uint16_t *p = plan->rev_table;
+    for (int i = 1; i < plan->N - 1; i++) {
+        int j = dsps_fft_plan_reverse(i, log2N, plan->radix);
+        if (i < j) {
+            *p++ = i * 8;
+            *p++ = j * 8;
+        }
+    }
+    if (count != plan->rev_size) {
+        *p++ = 0;
+        *p++ = 0;
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft_plan_init_fc32(dsps_fft_plan_t *plan, int N, int radix, float *w_buff)
+{
+    memset(plan, 0, sizeof(dsps_fft_plan_t));
+    if ((N < 2) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if ((radix != 2) && (radix != 4)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    plan->N = N;
+    plan->radix = radix;
+    plan->w_size = (radix == 4) ? N * 2 : N;
+
+    int w_len = (radix == 4) ? N * 4 : N;
+    plan->w = w_buff;
+    if (plan->w == NULL) {
+        plan->w = (float *)memalign(16, w_len * sizeof(float));
+        if (plan->w == NULL) {
+            return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+        }
+        plan->w_allocated = 1;
+    }
+
+    esp_err_t result = ESP_OK;
+    if (radix == 2) {
+        dsps_gen_w_r2_fc32(plan->w, N);
+        dsps_bit_rev_fc32_ansi(plan->w, N >> 1);
+    } else {
+        for (int i = 0; i < plan->w_size; i++) {
+            float angle = 2 * M_PI * i / (float)plan->w_size;
+            plan->w[2 * i + 0] = cosf(angle);
+            plan->w[2 * i + 1] = sinf(angle);
+        }
+    }
+
+    int log2N = dsp_power_of_two(N);
+    if ((N <= DSPS_FFT_PLAN_REV_TABLE_MAX_N) && ((radix == 2) || ((log2N & 1) == 0))) {
+        result = dsps_fft_plan_gen_rev_table(plan, log2N);
+    }
+    if (result != ESP_OK) {
+        dsps_fft_plan_free(plan);
+    }
+    return result;
+}
+
+void dsps_fft_plan_free(dsps_fft_plan_t *plan)
+{
+    if (plan->w_allocated) {
+        free(plan->w);
+    }
+    free(plan->rev_table);
+    memset(plan, 0, sizeof(dsps_fft_plan_t));
+}
+
+esp_err_t dsps_fft_plan_exec_fc32(const dsps_fft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (plan->radix == 4) {
+        return dsps_fft_plan_r4_fc32(data, plan->N, plan->w, plan->w_size);
+    }
+    return dsps_fft_plan_r2_fc32(data, plan->N, plan->w, plan->w_size);
+}
+
+esp_err_t dsps_fft_plan_bit_rev_fc32(const dsps_fft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (plan->rev_table != NULL) {
+        return dsps_bit_rev_lookup_fc32(data, plan->rev_size, plan->rev_table);
+    }
+    if (plan->radix == 2) {
+        return dsps_bit_rev_fc32_ansi(data, plan->N);
+    }
+    int log2N = dsp_power_of_two(plan->N);
+    if (log2N & 1) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    fc32_t *cplx = (fc32_t *)data;
+    for (int i = 1; i < plan->N - 1; i++) {
+        int j = dsps_fft_plan_reverse(i, log2N, 4);
+        if (i < j) {
+            fc32_t temp = cplx[i];
+            cplx[i] = cplx[j];
+            cplx[j] = temp;
+        }
+    }
+    return ESP_OK;
+}
+
+static int dsps_fft_plan_kernel_is_ansi(int radix)
+{
+#ifdef dsps_fft_plan_r2_ansi
+    if (radix == 2) {
+        return 1;
+    }
+#endif
+#ifdef dsps_fft_plan_r4_ansi
+    if (radix == 4) {
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+esp_err_t dsps_fft_plan_exec_batch_fc32(const dsps_fft_plan_t *plan, float *data, int frames, int frame_step, int elem_step)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((frames <= 0) || (frame_step <= 0) || (elem_step <= 0)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    // There are no optimized batch kernels yet: contiguous frames run the optimized single frame
+    // kernel, which is faster than the ANSI batch kernel, only the other layouts need the batch kernel.
+    if ((elem_step == 1) && !dsps_fft_plan_kernel_is_ansi(plan->radix)) {
+        for (int k = 0; k < frames; k++) {
+            esp_err_t result = dsps_fft_plan_exec_fc32(plan, &data[2 * k * frame_step]);
+            if (result != ESP_OK) {
+                return result;
+            }
+        }
+        return ESP_OK;
+    }
+    if (plan->radix == 4) {
+        return dsps_fft4r_batch_fc32_ansi_(data, plan->N, plan->w, plan->w_size, frames, frame_step, elem_step);
+    }
+    return dsps_fft2r_batch_fc32_ansi_(data, plan->N, plan->w, frames, frame_step, elem_step);
+}
+
+static void dsps_fft_plan_swap_batch(fc32_t *cplx, int i, int j, int frames, int frame_step, int elem_step)
+{
+    fc32_t *pi = &cplx[i * elem_step];
+    fc32_t *pj = &cplx[j * elem_step];
+    for (int k = 0; k < frames; k++) {
+        fc32_t temp = *pi;
+        *pi = *pj;
+        *pj = temp;
+        pi += frame_step;
+        pj += frame_step;
+    }
+}
+
+esp_err_t dsps_fft_plan_bit_rev_batch_fc32(const dsps_fft_plan_t *plan, float *data, int frames, int frame_step, int elem_step)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if ((frames <= 0) || (frame_step <= 0) || (elem_step <= 0)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    if (elem_step == 1) {
+        for (int k = 0; k < frames; k++) {
+            esp_err_t result = dsps_fft_plan_bit_rev_fc32(plan, &data[2 * k * frame_step]);
+            if (result != ESP_OK) {
+                return result;
+            }
+        }
+        return ESP_OK;
+    }
+
+    fc32_t *cplx = (fc32_t *)data;
+    if (plan->rev_table != NULL) {
+        // Byte offsets of complex floats, the padding pair (0, 0) swaps nothing
+        for (int p = 0; p < plan->rev_size; p++) {
+            int i = plan->rev_table[2 * p + 0] >> 3;
+            int j = plan->rev_table[2 * p + 1] >> 3;
+            dsps_fft_plan_swap_batch(cplx, i, j, frames, frame_step, elem_step);
+        }
+        return ESP_OK;
+    }
+    int log2N = dsp_power_of_two(plan->N);
+    if ((plan->radix == 4) && (log2N & 1)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    for (int i = 1; i < plan->N - 1; i++) {
+        int j = dsps_fft_plan_reverse(i, log2N, plan->radix);
+        if (i < j) {
+            dsps_fft_plan_swap_batch(cplx, i, j, frames, frame_step, elem_step);
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_rfft.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+#include "dsps_rfft_platform.h"
+
+// The real FFT variants combine the complex kernels of the chip with the dsps_cplx2real_fc32_ae32_ split step
+
+#if (dsps_rfft_fc32_ae32_enabled == 1)
+
+static esp_err_t dsps_rfft_fft_ae32(const dsps_fft_plan_t *fft, float *data)
+{
+    esp_err_t result;
+    if (fft->radix == 4) {
+#if (dsps_fft4r_fc32_ae32_enabled == 1)
+        result = dsps_fft4r_fc32_ae32_(data, fft->N, fft->w, fft->w_size);
+#else
+        result = dsps_fft4r_fc32_ansi_(data, fft->N, fft->w, fft->w_size);
+#endif // dsps_fft4r_fc32_ae32_enabled
+    } else {
+        result = dsps_fft2r_fc32_ae32_(data, fft->N, fft->w);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    if (fft->rev_table != NULL) {
+        return dsps_bit_rev_lookup_fc32_ae32(data, fft->rev_size, fft->rev_table);
+    }
+    return dsps_fft_plan_bit_rev_fc32(fft, data);
+}
+
+esp_err_t dsps_rfft_fc32_ae32(const dsps_rfft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int M = plan->fft.N;
+    esp_err_t result = dsps_rfft_fft_ae32(&plan->fft, data);
+    if (result != ESP_OK) {
+        return result;
+    }
+    result = dsps_cplx2real_fc32_ae32_(data, M, plan->w, 2 * M);
+    data[2 * M] = data[1];
+    data[2 * M + 1] = 0;
+    data[1] = 0;
+    return result;
+}
+
+esp_err_t dsps_irfft_fc32_ae32(const dsps_rfft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int M = plan->fft.N;
+    esp_err_t result = dsps_real2cplx_fc32_ansi_(data, M, plan->w, 2 * M);
+    if (result != ESP_OK) {
+        return result;
+    }
+    return dsps_rfft_fft_ae32(&plan->fft, data);
+}
+
+#endif // dsps_rfft_fc32_ae32_enabled
+
+#if (dsps_rfft_fc32_aes3_enabled == 1)
+
+static esp_err_t dsps_rfft_fft_aes3(const dsps_fft_plan_t *fft, float *data)
+{
+    esp_err_t result;
+    if (fft->radix == 4) {
+#if (dsps_fft4r_fc32_aes3_enabled == 1)
+        result = dsps_fft4r_fc32_aes3_(data, fft->N, fft->w, fft->w_size);
+#else
+        result = dsps_fft4r_fc32_ansi_(data, fft->N, fft->w, fft->w_size);
+#endif // dsps_fft4r_fc32_aes3_enabled
+    } else {
+        result = dsps_fft2r_fc32_aes3_(data, fft->N, fft->w);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    if (fft->rev_table != NULL) {
+        return dsps_bit_rev_lookup_fc32_aes3(data, fft->rev_size, fft->rev_table);
+    }
+    return dsps_fft_plan_bit_rev_fc32(fft, data);
+}
+
+esp_err_t dsps_rfft_fc32_aes3(const dsps_rfft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int M = plan->fft.N;
+    esp_err_t result = dsps_rfft_fft_aes3(&plan->fft, data);
+    if (result != ESP_OK) {
+        return result;
+    }
+    result = dsps_cplx2real_fc32_ae32_(data, M, plan->w, 2 * M);
+    data[2 * M] = data[1];
+    data[2 * M + 1] = 0;
+    data[1] = 0;
+    return result;
+}
+
+esp_err_t dsps_irfft_fc32_aes3(const dsps_rfft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int M = plan->fft.N;
+    esp_err_t result = dsps_real2cplx_fc32_ansi_(data, M, plan->w, 2 * M);
+    if (result != ESP_OK) {
+        return result;
+    }
+    return dsps_rfft_fft_aes3(&plan->fft, data);
+}
+
+#endif // dsps_rfft_fc32_aes3_enabled
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_rfft.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+#include <math.h>
+#include <string.h>
+#include <malloc.h>
+
+esp_err_t dsps_rfft_plan_init_fc32(dsps_rfft_plan_t *plan, int N)
+{
+    memset(plan, 0, sizeof(dsps_rfft_plan_t));
+    if ((N < 8) || !dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int M = N >> 1;
+    int radix = (dsp_power_of_two(M) & 1) ? 2 : 4;
+    esp_err_t result = dsps_fft_plan_init_fc32(&plan->fft, M, radix, NULL);
+    if (result != ESP_OK) {
+        return result;
+    }
+    // The split step reads entries k = 0..N/4 with the step table_size / M = 2
+    plan->w = (float *)memalign(16, (M + 2) * sizeof(float));
+    if (plan->w == NULL) {
+        dsps_fft_plan_free(&plan->fft);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    for (int k = 0; k <= M / 2; k++) {
+        float angle = 2 * M_PI * k / (float)N;
+        plan->w[2 * k + 0] = cosf(angle);
+        plan->w[2 * k + 1] = sinf(angle);
+    }
+    plan->N = N;
+    return ESP_OK;
+}
+
+void dsps_rfft_plan_free(dsps_rfft_plan_t *plan)
+{
+    dsps_fft_plan_free(&plan->fft);
+    free(plan->w);
+    memset(plan, 0, sizeof(dsps_rfft_plan_t));
+}
+
+esp_err_t dsps_real2cplx_fc32_ansi_(float *data, int N, float *table, int table_size)
+{
+    if (NULL == table) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int wind_step = table_size / N;
+    fc32_t *result = (fc32_t *)data;
+    float scale = 0.5f / N;
+
+    // Bins are written in reversed order, X[(N - k) % N], so the forward FFT calculates the inverse one
+    float re0 = result[0].re;
+    float reN = result[N].re;
+    result[0].re = (re0 + reN) * scale;
+    result[0].im = (re0 - reN) * scale;
+
+    for (int k = 1; k <= N / 2; k++) {
+        fc32_t xk = result[k];
+        fc32_t xnk = result[N - k];
+        fc32_t fe, fo;
+        // fe = (X[k] + conj(X[N-k])) / 2, fo = (X[k] - conj(X[N-k])) / 2 * exp(i*pi*k/N)
+        fe.re = xk.re + xnk.re;
+        fe.im = xk.im - xnk.im;
+        float dre = xk.re - xnk.re;
+        float dim = xk.im + xnk.im;
+        float c = table[k * wind_step + 0];
+        float s = table[k * wind_step + 1];
+        fo.re = dre * c - dim * s;
+        fo.im = dre * s + dim * c;
+
+        // Z[k] = fe + i*fo, Z[N-k] = conj(fe) + i*conj(fo)
+        result[k].re = (fe.re + fo.im) * scale;
+        result[k].im = (fo.re - fe.im) * scale;
+        result[N - k].re = (fe.re - fo.im) * scale;
+        result[N - k].im = (fe.im + fo.re) * scale;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t dsps_rfft_fft_ansi(const dsps_fft_plan_t *fft, float *data)
+{
+    esp_err_t result;
+    if (fft->radix == 4) {
+        result = dsps_fft4r_fc32_ansi_(data, fft->N, fft->w, fft->w_size);
+    } else {
+        result = dsps_fft2r_fc32_ansi_(data, fft->N, fft->w);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    if (fft->rev_table != NULL) {
+        return dsps_bit_rev_lookup_fc32_ansi(data, fft->rev_size, fft->rev_table);
+    }
+    return dsps_fft_plan_bit_rev_fc32(fft, data);
+}
+
+esp_err_t dsps_rfft_fc32_ansi(const dsps_rfft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int M = plan->fft.N;
+    esp_err_t result = dsps_rfft_fft_ansi(&plan->fft, data);
+    if (result != ESP_OK) {
+        return result;
+    }
+    result = dsps_cplx2real_fc32_ansi_(data, M, plan->w, 2 * M);
+    // dsps_cplx2real_fc32 packs the Nyquist bin into Im[0]
+    data[2 * M] = data[1];
+    data[2 * M + 1] = 0;
+    data[1] = 0;
+    return result;
+}
+
+esp_err_t dsps_irfft_fc32_ansi(const dsps_rfft_plan_t *plan, float *data)
+{
+    if (plan->w == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int M = plan->fft.N;
+    esp_err_t result = dsps_real2cplx_fc32_ansi_(data, M, plan->w, 2 * M);
+    if (result != ESP_OK) {
+        return result;
+    }
+    return dsps_rfft_fft_ansi(&plan->fft, data);
+}
@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_stft.h"
+#include "dsps_wind_hann.h"
+#include "dsps_mul.h"
+#include "dsps_add.h"
+#include "dsp_common.h"
+#include "dsp_block_buff.h"
+#include <string.h>
+#include <malloc.h>
+
+esp_err_t dsps_stft_init_f32(dsps_stft_t *stft, int frame_len, int hop, int fft_len, float *window)
+{
+    memset(stft, 0, sizeof(dsps_stft_t));
+    if ((frame_len <= 0) || (hop <= 0) || (hop > frame_len) || (fft_len < frame_len)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    esp_err_t result = dsps_rfft_plan_init_fc32(&stft->plan, fft_len);
+    if (result != ESP_OK) {
+        return result;
+    }
+    // The default window is carved from the same block as the other buffers
+    int total = DSP_BLOCK_BUFF_SIZE(fft_len + 2) + 2 * DSP_BLOCK_BUFF_SIZE(frame_len) + 2 * DSP_BLOCK_BUFF_SIZE(hop);
+    if (window == NULL) {
+        total += DSP_BLOCK_BUFF_SIZE(frame_len);
+    }
+    float *mem = (float *)memalign(16, total * sizeof(float));
+    if (mem == NULL) {
+        dsps_rfft_plan_free(&stft->plan);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    memset(mem, 0, total * sizeof(float));
+    stft->frame = dsp_block_buff_carve(&mem, fft_len + 2);
+    stft->in_buff = dsp_block_buff_carve(&mem, frame_len);
+    stft->out_buff = dsp_block_buff_carve(&mem, frame_len);
+    stft->norm = dsp_block_buff_carve(&mem, hop);
+    stft->out_ready = dsp_block_buff_carve(&mem, hop);
+    stft->window = window;
+    if (window == NULL) {
+        stft->window = dsp_block_buff_carve(&mem, frame_len);
+        dsps_wind_hann_f32(stft->window, frame_len);
+    }
+    stft->frame_len = frame_len;
+    stft->hop = hop;
+    stft->fft_len = fft_len;
+
+    // Every output sample is the sum of the frames over it, weighted by the squared window
+    for (int i = 0; i < hop; i++) {
+        float sum = 0;
+        for (int j = i; j < frame_len; j += hop) {
+            sum += stft->window[j] * stft->window[j];
+        }
+        if (sum < 1e-12f) {
+            dsps_stft_free(stft);
+            return ESP_ERR_DSP_INVALID_PARAM;
+        }
+        stft->norm[i] = 1.0f / sum;
+    }
+    return ESP_OK;
+}
+
+void dsps_stft_free(dsps_stft_t *stft)
+{
+    dsps_rfft_plan_free(&stft->plan);
+    free(stft->frame);
+    memset(stft, 0, sizeof(dsps_stft_t));
+}
+
+// Copies the input to the ring buffer up to the end of the current hop, returns the number of copied samples
+static int dsps_stft_push(dsps_stft_t *stft, const float *input, int len)
+{
+    int count = stft->hop - stft->in_count;
+    if (count > len) {
+        count = len;
+    }
+    int first = stft->frame_len - stft->in_pos;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(&stft->in_buff[stft->in_pos], input, first * sizeof(float));
+    memcpy(stft->in_buff, &input[first], (count - first) * sizeof(float));
+    stft->in_pos += count;
+    if (stft->in_pos >= stft->frame_len) {
+        stft->in_pos -= stft->frame_len;
+    }
+    stft->in_count += count;
+    return count;
+}
+
+// Windows the last frame_len samples of the ring buffer and calculates the spectrum in the frame buffer
+static esp_err_t dsps_stft_frame(dsps_stft_t *stft)
+{
+    int first = stft->frame_len - stft->in_pos;
+    esp_err_t result = dsps_mul_f32(&stft->in_buff[stft->in_pos], stft->window, stft->frame, first, 1, 1, 1);
+    if ((result == ESP_OK) && (stft->in_pos > 0)) {
+        result = dsps_mul_f32(stft->in_buff, &stft->window[first], &stft->frame[first], stft->in_pos, 1, 1, 1);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    memset(&stft->frame[stft->frame_len], 0, (stft->fft_len - stft->frame_len) * sizeof(float));
+    stft->in_count = 0;
+    return dsps_rfft_fc32(&stft->plan, stft->frame);
+}
+
+esp_err_t dsps_stft_f32(dsps_stft_t *stft, const float *input, int len, dsps_stft_frame_func_t frame_func, void *arg)
+{
+    if (stft->frame == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    if (frame_func == NULL) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    int pos = 0;
+    while (pos < len) {
+        pos += dsps_stft_push(stft, &input[pos], len - pos);
+        if (stft->in_count == stft->hop) {
+            esp_err_t result = dsps_stft_frame(stft);
+            if (result != ESP_OK) {
+                return result;
+            }
+            frame_func(stft->frame, stft->fft_len, arg);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_istft_f32(dsps_stft_t *stft, float *spectrum, float *output)
+{
+    if (stft->frame == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int frame_len = stft->frame_len;
+    int hop = stft->hop;
+    esp_err_t result = dsps_irfft_fc32(&stft->plan, spectrum);
+    if (result != ESP_OK) {
+        return result;
+    }
+    result = dsps_mul_f32(spectrum, stft->window, spectrum, frame_len, 1, 1, 1);
+    if (result == ESP_OK) {
+        result = dsps_add_f32(stft->out_buff, spectrum, stft->out_buff, frame_len, 1, 1, 1);
+    }
+    // The first hop samples have got all the frames over them
+    if (result == ESP_OK) {
+        result = dsps_mul_f32(stft->out_buff, stft->norm, output, hop, 1, 1, 1);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    memmove(stft->out_buff, &stft->out_buff[hop], (frame_len - hop) * sizeof(float));
+    memset(&stft->out_buff[frame_len - hop], 0, hop * sizeof(float));
+    return ESP_OK;
+}
+
+esp_err_t dsps_stft_process_f32(dsps_stft_t *stft, const float *input, float *output, int len, dsps_stft_frame_func_t frame_func, void *arg)
+{
+    if (stft->frame == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    int pos = 0;
+    while (pos < len) {
+        // The output of the previous frame is read at the same rate as the input is pushed
+        int out_pos = stft->in_count;
+        int count = dsps_stft_push(stft, &input[pos], len - pos);
+        memcpy(&output[pos], &stft->out_ready[out_pos], count * sizeof(float));
+        pos += count;
+        if (stft->in_count == stft->hop) {
+            esp_err_t result = dsps_stft_frame(stft);
+            if (result != ESP_OK) {
+                return result;
+            }
+            if (frame_func != NULL) {
+                frame_func(stft->frame, stft->fft_len, arg);
+            }
+            result = dsps_istft_f32(stft, stft->frame, stft->out_ready);
+            if (result != ESP_OK) {
+                return result;
+            }
+        }
+    }
+    return ESP_OK;
+}
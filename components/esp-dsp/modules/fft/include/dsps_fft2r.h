@@ -200,6 +200,54 @@ esp_err_t dsps_cplx2reC_sc16(int16_t *data, int N);
  */
 esp_err_t dsps_cplx2real_sc16_ansi(int16_t *data, int N);
 /**@}*/
+
+/**
+ * @brief      Complex FFT of radix 2 with block floating point scaling
+ *
+ * Complex FFT of radix 2 for 16 bit data with a shared exponent of the whole block.
+ * The input is normalized to the full range first, and every stage is scaled only
+ * when the data could overflow, so quiet signals keep their precision.
+ * The true FFT result is data * 2^exponent. The result is in bit reversed order,
+ * dsps_bit_rev_sc16_ansi(...) returns it to the natural order.
+ * The function uses the table of dsps_fft2r_init_sc16(...).
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[inout] data: input/output complex array. An elements located: Re[0], Im[0], ... Re[N-1], Im[N-1]
+ *               result of FFT will be stored to this array.
+ * @param[in] N: Number of complex elements in input array
+ * @param[in] w: pointer to the sin/cos table
+ * @param[out] exponent: exponent of the result
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft2r_bfp_sc16_ansi_(int16_t *data, int N, int16_t *w, int *exponent);
+#define dsps_fft2r_bfp_sc16_ansi(data, N, exponent) dsps_fft2r_bfp_sc16_ansi_(data, N, dsps_fft_w_table_sc16, exponent)
+
+/**
+ * @brief      Real FFT with block floating point scaling
+ *
+ * FFT of N real 16 bit samples, calculated as dsps_fft2r_bfp_sc16_ansi(...) of N/2 points
+ * followed by the split step. The result is the half spectrum of N/2+1 complex bins
+ * in natural order: Re[0], Im[0], ... Re[N/2], Im[N/2], where Im[0] and Im[N/2] are 0.
+ * The true FFT result is data * 2^exponent.
+ * The table of dsps_fft2r_init_sc16(...) must have at least N entries.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[inout] data: N real samples on input, N/2+1 complex bins on output.
+ *                     The array must have N+2 elements.
+ * @param[in] N: Number of real samples, at least 4
+ * @param[in] w: pointer to the sin/cos table
+ * @param[out] exponent: exponent of the result
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_rfft_bfp_sc16_ansi_(int16_t *data, int N, int16_t *w, int *exponent);
+#define dsps_rfft_bfp_sc16_ansi(data, N, exponent) dsps_rfft_bfp_sc16_ansi_(data, N, dsps_fft_w_table_sc16, exponent)
+
 esp_err_t dsps_cplx2real256_fc32_ansi(float *data);
 
 esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsps_fft_mr_H_
+#define _dsps_fft_mr_H_
+
+#include "dsp_err.h"
+#include "sdkconfig.h"
+#include "dsps_fft_plan.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DSPS_FFT_MR_MAX_FACTORS 16
+
+/**
+ * @brief Data struct of the mixed radix FFT plan
+ *
+ * The FFT of N = P * Q points, where P is a power of two and Q = 3^a * 5^b, is calculated as
+ * Q FFTs of P points with the radix-2 or radix-4 kernels, twiddle multiplication, and
+ * P FFTs of Q points with radix-3 and radix-5 butterflies.
+ * Sizes of the speech front ends, 160, 320, 400, 480, are supported without zero padding.
+ * The gain is the exact frame length, not speed: the transpose and twiddle passes cost about
+ * as much as the saved butterflies, so 400 points take about the same cycles as the zero padded
+ * 512 points radix-2 FFT, 480 points take more, and only 160 and 320 points are faster.
+ * The plan contains a scratch buffer, so one plan must not be executed from several tasks at the same time.
+ * A user should access this structure only in case of extensions for the DSP Library.
+ * To initialize the plan, use the dsps_fft_mr_plan_init_fc32() function.
+ * To execute the FFT, use the dsps_fft_mr_fc32() function.
+ * To free the plan, use the dsps_fft_mr_plan_free() function.
+ */
+typedef struct dsps_fft_mr_plan_s {
+    dsps_fft_plan_t fft;        /*!< Plan of the P points FFT, not initialized if P is 1.*/
+    float  *w;                  /*!< exp(-2*pi*i*k/N) for k = 0..N-1, complex.*/
+    float  *scratch;            /*!< Scratch buffer of N + Q complex points.*/
+    int     N;                  /*!< FFT size in complex points.*/
+    int     P;                  /*!< Power of two factor of N.*/
+    int     Q;                  /*!< Product of the radix-3 and radix-5 factors of N.*/
+    int     factors[2 * DSPS_FFT_MR_MAX_FACTORS]; /*!< Radix and remaining length of every stage of the Q points FFT.*/
+    int     factors_count;      /*!< Number of stages of the Q points FFT.*/
+} dsps_fft_mr_plan_t;
+
+/**
+ * @brief   initialize mixed radix FFT plan
+ *
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param plan: pointer to the plan structure, that must be preallocated
+ * @param N: FFT size in complex points, N = 2^a * 3^b * 5^c, at least 2
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if N has other prime factors
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if memory allocation fails
+ */
+esp_err_t dsps_fft_mr_plan_init_fc32(dsps_fft_mr_plan_t *plan, int N);
+
+/**
+ * @brief   free mixed radix FFT plan
+ *
+ * @param plan: pointer to the plan structure
+ */
+void dsps_fft_mr_plan_free(dsps_fft_mr_plan_t *plan);
+
+/**@{*/
+/**
+ * @brief   mixed radix complex FFT
+ *
+ * Forward FFT of N complex points, in place. The result is in natural order and not scaled.
+ * The function without extension runs the radix-2 and radix-4 stages with the optimized
+ * kernels of the target, the same as dsps_fft_plan_exec_fc32().
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ *
+ * @param plan: initialized plan
+ * @param[inout] data: input/output complex array: Re[0], Im[0], ... Re[N-1], Im[N-1]
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the plan is not initialized
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft_mr_fc32_ansi(dsps_fft_mr_plan_t *plan, float *data);
+esp_err_t dsps_fft_mr_fc32(dsps_fft_mr_plan_t *plan, float *data);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fft_mr_H_
@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsps_fft_plan_H_
+#define _dsps_fft_plan_H_
+
+#include "dsp_err.h"
+#include "sdkconfig.h"
+#include "dsps_fft2r.h"
+#include "dsps_fft4r.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of the complex FFT plan
+ *
+ * The plan owns the sin/cos table and the bit reverse table of one FFT size, so any number of
+ * plans of different sizes can be used at the same time, from different tasks and cores, without
+ * dsps_fft2r_init_fc32(...) / dsps_fft4r_init_fc32(...). A plan is read-only after initialization.
+ * A user should access this structure only in case of extensions for the DSP Library.
+ * To initialize the plan, use the dsps_fft_plan_init_fc32() function.
+ * To execute the FFT, use the dsps_fft_plan_exec_fc32() and dsps_fft_plan_bit_rev_fc32() functions.
+ * To free the plan, use the dsps_fft_plan_free() function.
+ */
+typedef struct dsps_fft_plan_s {
+    float    *w;            /*!< sin/cos table in the format of the radix-2 or radix-4 kernels.*/
+    int       w_size;       /*!< table_size argument of the radix-4 kernels, N for radix-2.*/
+    uint16_t *rev_table;    /*!< Bit reverse table in the dsps_bit_rev_lookup_fc32(...) format, NULL if not used.*/
+    int       rev_size;     /*!< Number of index pairs in rev_table.*/
+    int       N;            /*!< FFT size in complex points.*/
+    int       radix;        /*!< 2 or 4.*/
+    int16_t   w_allocated;  /*!< The sin/cos table was allocated by the init function.*/
+} dsps_fft_plan_t;
+
+/**
+ * @brief   initialize complex FFT plan
+ *
+ * Calculates the sin/cos table and the bit reverse table for one FFT size.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param plan: pointer to the plan structure, that must be preallocated
+ * @param N: FFT size in complex points, power of two. Radix-4 plans can be created for any power of two
+ *           to be used as a twiddle table for smaller sizes and dsps_cplx2real_fc32_ansi_(...),
+ *           but dsps_fft_plan_exec_fc32() requires a power of four.
+ * @param radix: 2 or 4
+ * @param w_buff: buffer for the sin/cos table, N floats for radix 2 and 4*N floats for radix 4.
+ *                If NULL, the buffer will be allocated internally.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if N is not a power of two
+ *      - ESP_ERR_DSP_INVALID_PARAM if radix is not 2 or 4
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if memory allocation fails
+ */
+esp_err_t dsps_fft_plan_init_fc32(dsps_fft_plan_t *plan, int N, int radix, float *w_buff);
+
+/**
+ * @brief   free complex FFT plan
+ *
+ * Frees the tables allocated by dsps_fft_plan_init_fc32(). The plan can be initialized again after that.
+ *
+ * @param plan: pointer to the plan structure
+ */
+void dsps_fft_plan_free(dsps_fft_plan_t *plan);
+
+/**
+ * @brief   complex FFT with a plan
+ *
+ * Calculates the butterflies of the FFT with the optimized radix-2 or radix-4 kernel of the target.
+ * The result is in bit reversed order, as for dsps_fft2r_fc32(...) and dsps_fft4r_fc32(...).
+ *
+ * @param plan: initialized plan
+ * @param[inout] data: input/output complex array of plan->N elements: Re[0], Im[0], ... Re[N-1], Im[N-1]
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the plan is not initialized
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft_plan_exec_fc32(const dsps_fft_plan_t *plan, float *data);
+
+/**
+ * @brief   bit reverse with a plan
+ *
+ * Restores the natural order of the result of dsps_fft_plan_exec_fc32().
+ *
+ * @param plan: initialized plan
+ * @param[inout] data: complex array of plan->N elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the plan is not initialized
+ */
+esp_err_t dsps_fft_plan_bit_rev_fc32(const dsps_fft_plan_t *plan, float *data);
+
+/**
+ * @brief   batched complex FFT with a plan
+ *
+ * Calculates the FFT of several frames of plan->N points in one call.
+ * Element i of frame k is located at complex index k*frame_step + i*elem_step, so
+ * frames one after another use elem_step = 1 and frame_step >= N, and interleaved frames
+ * use elem_step = frames and frame_step = 1.
+ * The butterflies of a stage run over all frames in the inner loop, so every twiddle is loaded
+ * once for all frames and the loop overhead is shared by the frames.
+ * On targets with optimized single frame kernels, contiguous frames (elem_step = 1) are
+ * calculated by the optimized kernel frame by frame, the other layouts use the ANSI C batch kernels.
+ * The result is in bit reversed order, dsps_fft_plan_bit_rev_batch_fc32() restores the natural order.
+ *
+ * @param plan: initialized plan
+ * @param[inout] data: input/output complex array of all frames
+ * @param frames: number of frames
+ * @param frame_step: distance between the frames, in complex elements
+ * @param elem_step: distance between the elements of a frame, in complex elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the plan is not initialized
+ *      - ESP_ERR_DSP_INVALID_PARAM if the steps or the number of frames are not valid
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft_plan_exec_batch_fc32(const dsps_fft_plan_t *plan, float *data, int frames, int frame_step, int elem_step);
+
+/**
+ * @brief   batched bit reverse with a plan
+ *
+ * Restores the natural order of the result of dsps_fft_plan_exec_batch_fc32().
+ *
+ * @param plan: initialized plan
+ * @param[inout] data: complex array of all frames
+ * @param frames: number of frames
+ * @param frame_step: distance between the frames, in complex elements
+ * @param elem_step: distance between the elements of a frame, in complex elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the plan is not initialized
+ *      - ESP_ERR_DSP_INVALID_PARAM if the steps or the number of frames are not valid
+ */
+esp_err_t dsps_fft_plan_bit_rev_batch_fc32(const dsps_fft_plan_t *plan, float *data, int frames, int frame_step, int elem_step);
+
+/**@{*/
+/**
+ * @brief   batched FFT kernels
+ *
+ * Radix-2 and radix-4 butterflies of several frames with the layout of dsps_fft_plan_exec_batch_fc32().
+ * Every twiddle is loaded once and applied to all frames.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[inout] data: input/output complex array of all frames
+ * @param N: FFT size in complex points
+ * @param w: sin/cos table of the radix-2 or radix-4 kernel
+ * @param table_size: table_size argument of the radix-4 kernel
+ * @param frames: number of frames
+ * @param frame_step: distance between the frames, in complex elements
+ * @param elem_step: distance between the elements of a frame, in complex elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft2r_batch_fc32_ansi_(float *data, int N, float *w, int frames, int frame_step, int elem_step);
+esp_err_t dsps_fft4r_batch_fc32_ansi_(float *data, int N, float *w, int table_size, int frames, int frame_step, int elem_step);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fft_plan_H_
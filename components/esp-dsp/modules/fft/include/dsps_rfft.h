@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsps_rfft_H_
+#define _dsps_rfft_H_
+
+#include "dsp_err.h"
+#include "sdkconfig.h"
+#include "dsps_fft_plan.h"
+#include "dsps_rfft_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of the real FFT plan
+ *
+ * The real FFT of N samples is calculated as a complex FFT of N/2 points followed by a split step,
+ * so it takes about half of the time and memory of a complex FFT of the same length.
+ * The plan is read-only after initialization and can be shared between tasks.
+ * A user should access this structure only in case of extensions for the DSP Library.
+ * To initialize the plan, use the dsps_rfft_plan_init_fc32() function.
+ * To execute the transforms, use the dsps_rfft_fc32() and dsps_irfft_fc32() functions.
+ * To free the plan, use the dsps_rfft_plan_free() function.
+ */
+typedef struct dsps_rfft_plan_s {
+    dsps_fft_plan_t fft;    /*!< Complex plan of N/2 points, radix-4 if N/2 is a power of four.*/
+    float          *w;      /*!< cos/sin of 2*pi*k/N for k = 0..N/4, in the dsps_cplx2real_fc32_ansi_(...) table format.*/
+    int             N;      /*!< Number of real samples.*/
+} dsps_rfft_plan_t;
+
+/**
+ * @brief   initialize real FFT plan
+ *
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param plan: pointer to the plan structure, that must be preallocated
+ * @param N: number of real samples, power of two, at least 8
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if N is not a power of two or less than 8
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if memory allocation fails
+ */
+esp_err_t dsps_rfft_plan_init_fc32(dsps_rfft_plan_t *plan, int N);
+
+/**
+ * @brief   free real FFT plan
+ *
+ * @param plan: pointer to the plan structure
+ */
+void dsps_rfft_plan_free(dsps_rfft_plan_t *plan);
+
+/**@{*/
+/**
+ * @brief   real FFT
+ *
+ * Forward FFT of N real samples, in place. The result is the half spectrum of N/2+1 complex bins
+ * in natural order: Re[0], Im[0], ... Re[N/2], Im[N/2], where Im[0] and Im[N/2] are 0.
+ * The result is not scaled.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_aes3) is optimized for ESP32S3 chip.
+ *
+ * @param plan: initialized real FFT plan
+ * @param[inout] data: N real samples on input, N/2+1 complex bins on output.
+ *                     The array must have N+2 elements.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the plan is not initialized
+ */
+esp_err_t dsps_rfft_fc32_ansi(const dsps_rfft_plan_t *plan, float *data);
+esp_err_t dsps_rfft_fc32_ae32(const dsps_rfft_plan_t *plan, float *data);
+esp_err_t dsps_rfft_fc32_aes3(const dsps_rfft_plan_t *plan, float *data);
+/**@}*/
+
+/**@{*/
+/**
+ * @brief   inverse real FFT
+ *
+ * Inverse of dsps_rfft_fc32(), in place, scaled by 1/N: dsps_irfft_fc32(dsps_rfft_fc32(x)) == x.
+ * Im[0] and Im[N/2] of the input are ignored.
+ * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
+ * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_aes3) is optimized for ESP32S3 chip.
+ *
+ * @param plan: initialized real FFT plan
+ * @param[inout] data: N/2+1 complex bins on input, N real samples on output.
+ *                     The array must have N+2 elements.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the plan is not initialized
+ */
+esp_err_t dsps_irfft_fc32_ansi(const dsps_rfft_plan_t *plan, float *data);
+esp_err_t dsps_irfft_fc32_ae32(const dsps_rfft_plan_t *plan, float *data);
+esp_err_t dsps_irfft_fc32_aes3(const dsps_rfft_plan_t *plan, float *data);
+/**@}*/
+
+/**
+ * @brief      Convert half spectrum of a real signal to the input of a complex FFT
+ *
+ * Inverse of dsps_cplx2real_fc32_ansi_(...). Prepares N complex points from the N+1 bins of
+ * the spectrum of 2*N real samples, such that the forward complex FFT of N points, with bit reverse,
+ * gives back the real samples. The result is scaled by 1/N.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param[inout] data: Re[0], Im[0], ... Re[N], Im[N] on input, N complex points on output
+ * @param[in] N: Number of complex points of the FFT
+ * @param[in] table: pointer to sin/cos table in the dsps_cplx2real_fc32_ansi_(...) format
+ * @param[in] table_size: size of the sin/cos table
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_real2cplx_fc32_ansi_(float *data, int N, float *table, int table_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if CONFIG_DSP_OPTIMIZED
+
+#if (dsps_rfft_fc32_aes3_enabled == 1)
+#define dsps_rfft_fc32 dsps_rfft_fc32_aes3
+#define dsps_irfft_fc32 dsps_irfft_fc32_aes3
+#elif (dsps_rfft_fc32_ae32_enabled == 1)
+#define dsps_rfft_fc32 dsps_rfft_fc32_ae32
+#define dsps_irfft_fc32 dsps_irfft_fc32_ae32
+#else
+#define dsps_rfft_fc32 dsps_rfft_fc32_ansi
+#define dsps_irfft_fc32 dsps_irfft_fc32_ansi
+#endif
+
+#else // CONFIG_DSP_OPTIMIZED
+
+#define dsps_rfft_fc32 dsps_rfft_fc32_ansi
+#define dsps_irfft_fc32 dsps_irfft_fc32_ansi
+
+#endif // CONFIG_DSP_OPTIMIZED
+
+#endif // _dsps_rfft_H_
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsps_stft_H_
+#define _dsps_stft_H_
+
+#include "dsp_err.h"
+#include "dsps_rfft.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Frame processing function of the STFT
+ *
+ * Called for every frame with its spectrum: N/2+1 complex bins in the dsps_rfft_fc32() format.
+ * The spectrum could be modified in place before it goes to the synthesis.
+ *
+ * @param spectrum: Re[0], Im[0], ... Re[N/2], Im[N/2] of the frame, N+2 elements
+ * @param N: FFT length
+ * @param arg: user argument passed to dsps_stft_f32() or dsps_stft_process_f32()
+ */
+typedef void (*dsps_stft_frame_func_t)(float *spectrum, int N, void *arg);
+
+/**
+ * @brief Data struct of the STFT analysis and ISTFT synthesis
+ *
+ * This structure is used by the STFT internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_stft_init_f32(...) function.
+ * All buffers are allocated by the init function, processing does not allocate memory.
+ */
+typedef struct dsps_stft_s {
+    dsps_rfft_plan_t plan;      /*!< Real FFT plan of fft_len points.*/
+    float  *window;             /*!< Analysis and synthesis window, frame_len samples.*/
+    float  *norm;               /*!< Inverse of the overlapped squared window, hop samples.*/
+    float  *in_buff;            /*!< Input ring buffer, frame_len samples.*/
+    float  *out_buff;           /*!< Overlap-add accumulator, frame_len samples.*/
+    float  *out_ready;          /*!< Finished output samples of dsps_stft_process_f32(), hop samples.*/
+    float  *frame;              /*!< Frame and spectrum scratch buffer, fft_len + 2 samples.*/
+    int     frame_len;          /*!< Frame length.*/
+    int     hop;                /*!< Hop between the frames.*/
+    int     fft_len;            /*!< FFT length, the frame is zero padded up to it.*/
+    int     in_pos;             /*!< Write position in the input ring buffer.*/
+    int     in_count;           /*!< Samples pushed since the last frame.*/
+} dsps_stft_t;
+
+/**
+ * @brief   initialize STFT structure
+ *
+ * The same window is used for the analysis and the synthesis. The synthesis is normalized
+ * by the overlapped squared window, so any window and hop give perfect reconstruction,
+ * as long as the frames overlap with nonzero window values.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param stft: pointer to the STFT structure, that must be preallocated
+ * @param frame_len: frame length
+ * @param hop: hop between the frames, from 1 to frame_len
+ * @param fft_len: FFT length, power of two, not less than frame_len
+ * @param window: window of frame_len samples, for example from dsps_wind_hann_f32().
+ *                The buffer must be valid while the STFT is used.
+ *                If NULL, the Hann window is allocated and generated.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if the lengths are not valid
+ *      - ESP_ERR_DSP_INVALID_PARAM if the window does not allow reconstruction with this hop
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if memory allocation fails
+ */
+esp_err_t dsps_stft_init_f32(dsps_stft_t *stft, int frame_len, int hop, int fft_len, float *window);
+
+/**
+ * @brief   free STFT structure
+ *
+ * @param stft: pointer to the STFT structure
+ */
+void dsps_stft_free(dsps_stft_t *stft);
+
+/**
+ * @brief   STFT analysis
+ *
+ * Pushes any number of samples to the input ring buffer. For every hop samples the last
+ * frame_len samples are windowed, transformed, and passed to frame_func.
+ * The input before the first push is zero.
+ *
+ * @param stft: initialized STFT structure
+ * @param[in] input: input samples
+ * @param len: number of input samples
+ * @param frame_func: function called for every frame
+ * @param arg: user argument of frame_func
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stft_f32(dsps_stft_t *stft, const float *input, int len, dsps_stft_frame_func_t frame_func, void *arg);
+
+/**
+ * @brief   ISTFT synthesis
+ *
+ * Calculates the inverse FFT of one frame, windows it, and adds it to the overlap-add accumulator.
+ * The next hop output samples are finished and stored to the output.
+ *
+ * @param stft: initialized STFT structure
+ * @param[inout] spectrum: spectrum of the frame in the dsps_rfft_fc32() format, fft_len + 2 elements.
+ *                         The content is destroyed.
+ * @param[out] output: hop output samples
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_istft_f32(dsps_stft_t *stft, float *spectrum, float *output);
+
+/**
+ * @brief   STFT analysis, frame processing and ISTFT synthesis
+ *
+ * Streams any number of samples through the analysis, frame_func, and the synthesis.
+ * The output has the same length as the input and is delayed by frame_len samples,
+ * so with an empty frame_func output[i] == input[i - frame_len].
+ * Use either this function, or dsps_stft_f32() and dsps_istft_f32() with the same structure.
+ *
+ * @param stft: initialized STFT structure
+ * @param[in] input: input samples
+ * @param[out] output: output samples
+ * @param len: number of samples
+ * @param frame_func: function called for every frame, could be NULL
+ * @param arg: user argument of frame_func
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stft_process_f32(dsps_stft_t *stft, const float *input, float *output, int len, dsps_stft_frame_func_t frame_func, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_stft_H_
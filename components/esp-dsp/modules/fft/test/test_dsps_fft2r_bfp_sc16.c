@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_fft2r.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fft2r_bfp_sc16";
+
+// Signal to noise ratio of the result against the direct DFT in double precision, in dB
+static float check_snr(const int16_t *input, const int16_t *result, int exponent, int N, int bins, int real)
+{
+    double signal = 0;
+    double noise = 0;
+    float scale = ldexpf(1, exponent);
+    for (int k = 0 ; k < bins ; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0 ; n < N ; n++) {
+            double angle = -2 * M_PI * (double)((long)k * n % N) / N;
+            double x_re = real ? input[n] : input[n * 2 + 0];
+            double x_im = real ? 0 : input[n * 2 + 1];
+            re += x_re * cos(angle) - x_im * sin(angle);
+            im += x_re * sin(angle) + x_im * cos(angle);
+        }
+        double err_re = re - result[k * 2 + 0] * scale;
+        double err_im = im - result[k * 2 + 1] * scale;
+        signal += re * re + im * im;
+        noise += err_re * err_re + err_im * err_im;
+    }
+    return 10 * log10(signal / (noise + 1e-20));
+}
+
+static void fill_test_data(int16_t *data, int N, float amplitude)
+{
+    for (int i = 0 ; i < N ; i++) {
+        data[i * 2 + 0] = amplitude * (0.7f * sinf(2 * M_PI * 13 * i / N) + 0.3f * cosf(2 * M_PI * 41 * i / N));
+        data[i * 2 + 1] = amplitude * 0.5f * sinf(2 * M_PI * 5 * i / N);
+    }
+}
+
+TEST_CASE("dsps_fft2r_bfp_sc16_ansi functionality", "[dsps]")
+{
+    const int N = 256;
+    int16_t *input = (int16_t *)memalign(16, (N * 2 + 2) * sizeof(int16_t));
+    int16_t *data = (int16_t *)memalign(16, (N * 2 + 2) * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ESP_OK(dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+
+    // Quiet speech level, full scale, and a maximum that makes every stage to scale
+    const float amplitudes[] = {100, 8000, 32767};
+    for (int a = 0 ; a < 3 ; a++) {
+        fill_test_data(input, N, amplitudes[a]);
+        int exponent = 0;
+
+        memcpy(data, input, N * 2 * sizeof(int16_t));
+        TEST_ESP_OK(dsps_fft2r_bfp_sc16_ansi(data, N, &exponent));
+        TEST_ESP_OK(dsps_bit_rev_sc16_ansi(data, N));
+        float snr_bfp = check_snr(input, data, exponent, N, N, 0);
+
+        // Fixed scaling by 2 on every stage
+        memcpy(data, input, N * 2 * sizeof(int16_t));
+        TEST_ESP_OK(dsps_fft2r_sc16_ansi(data, N));
+        TEST_ESP_OK(dsps_bit_rev_sc16_ansi(data, N));
+        float snr_fixed = check_snr(input, data, dsp_power_of_two(N), N, N, 0);
+
+        ESP_LOGI(TAG, "amplitude %6.0f: complex FFT SNR %5.1f dB, exponent %i, with fixed scaling %5.1f dB", amplitudes[a], snr_bfp, exponent, snr_fixed);
+        if ((snr_bfp < 60) || (snr_bfp < snr_fixed - 1)) {
+            TEST_ASSERT_MESSAGE(false, "Complex FFT SNR lower than expected!");
+        }
+        // The fixed scaling loses the most of the quiet signal precision
+        if ((amplitudes[a] < 1000) && (snr_bfp < snr_fixed + 20)) {
+            TEST_ASSERT_MESSAGE(false, "Block floating point gain lower than expected!");
+        }
+
+        // Real input
+        for (int i = 0 ; i < N ; i++) {
+            input[i] = input[i * 2];
+        }
+        memcpy(data, input, N * sizeof(int16_t));
+        TEST_ESP_OK(dsps_rfft_bfp_sc16_ansi(data, N, &exponent));
+        float snr_real = check_snr(input, data, exponent, N, N / 2 + 1, 1);
+        ESP_LOGI(TAG, "amplitude %6.0f: real FFT SNR %5.1f dB, exponent %i", amplitudes[a], snr_real, exponent);
+        if (snr_real < 60) {
+            TEST_ASSERT_MESSAGE(false, "Real FFT SNR lower than expected!");
+        }
+        TEST_ASSERT_EQUAL(0, data[1]);
+        TEST_ASSERT_EQUAL(0, data[N + 1]);
+    }
+
+    // Zero input keeps the zero exponent
+    int exponent = 1;
+    memset(data, 0, N * 2 * sizeof(int16_t));
+    TEST_ESP_OK(dsps_fft2r_bfp_sc16_ansi(data, N, &exponent));
+    TEST_ASSERT_EQUAL(0, exponent);
+
+    dsps_fft2r_deinit_sc16();
+    free(input);
+    free(data);
+}
+
+TEST_CASE("dsps_fft2r_bfp_sc16_ansi benchmark", "[dsps]")
+{
+    const int N = 1024;
+    int16_t *data = (int16_t *)memalign(16, (N * 2 + 2) * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ESP_OK(dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    int exponent;
+
+    fill_test_data(data, N, 1000);
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_fft2r_bfp_sc16_ansi(data, N, &exponent);
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    int cycles_bfp = end_b - start_b;
+
+    fill_test_data(data, N, 1000);
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_fft2r_sc16_ansi(data, N);
+    end_b = dsp_get_cpu_cycle_count();
+    int cycles_fixed = end_b - start_b;
+
+    fill_test_data(data, N, 1000);
+    start_b = dsp_get_cpu_cycle_count();
+    dsps_rfft_bfp_sc16_ansi(data, N, &exponent);
+    end_b = dsp_get_cpu_cycle_count();
+    int cycles_real = end_b - start_b;
+
+    ESP_LOGI(TAG, "Benchmark %i points: dsps_fft2r_bfp_sc16_ansi - %i cycles, dsps_fft2r_sc16_ansi - %i cycles, dsps_rfft_bfp_sc16_ansi - %i cycles",
+             N, cycles_bfp, cycles_fixed, cycles_real);
+    TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_bfp);
+    TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_real);
+
+    dsps_fft2r_deinit_sc16();
+    free(data);
+}
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_fft_plan.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fft_batch";
+
+#define BATCH_FRAMES 4
+#define BATCH_MAX_N 512
+#define BATCH_GAP 8
+
+static void fill_frame(float *data, int N, int frame)
+{
+    for (int i = 0 ; i < N ; i++) {
+        data[i * 2 + 0] = sinf(2 * M_PI * (3 + frame * 7) * i / N) + 0.1f * frame;
+        data[i * 2 + 1] = 0.5f * cosf(2 * M_PI * (11 + frame) * i / N);
+    }
+}
+
+// Frame k is copied to or from the batch layout
+static void copy_frame(float *batch, float *frame, int N, int k, int frame_step, int elem_step, int to_batch)
+{
+    for (int i = 0 ; i < N ; i++) {
+        float *p = &batch[2 * (k * frame_step + i * elem_step)];
+        if (to_batch) {
+            p[0] = frame[i * 2 + 0];
+            p[1] = frame[i * 2 + 1];
+        } else {
+            frame[i * 2 + 0] = p[0];
+            frame[i * 2 + 1] = p[1];
+        }
+    }
+}
+
+TEST_CASE("dsps_fft_plan_exec_batch_fc32 functionality", "[dsps]")
+{
+    float *batch = (float *)memalign(16, 2 * BATCH_FRAMES * (BATCH_MAX_N + BATCH_GAP) * sizeof(float));
+    float *frame = (float *)memalign(16, 2 * BATCH_MAX_N * sizeof(float));
+    float *check = (float *)memalign(16, 2 * BATCH_MAX_N * sizeof(float));
+    TEST_ASSERT_NOT_NULL(batch);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_NOT_NULL(check);
+
+    // N, radix
+    const int configs[][2] = {{256, 2}, {256, 4}, {512, 2}, {64, 4}};
+    for (int c = 0 ; c < sizeof(configs) / sizeof(configs[0]) ; c++) {
+        int N = configs[c][0];
+        dsps_fft_plan_t plan;
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan, N, configs[c][1], NULL));
+        // Frames one after another with a gap, and interleaved frames
+        const int layouts[][2] = {{N + BATCH_GAP, 1}, {1, BATCH_FRAMES}};
+        for (int l = 0 ; l < 2 ; l++) {
+            int frame_step = layouts[l][0];
+            int elem_step = layouts[l][1];
+            for (int k = 0 ; k < BATCH_FRAMES ; k++) {
+                fill_frame(frame, N, k);
+                copy_frame(batch, frame, N, k, frame_step, elem_step, 1);
+            }
+            TEST_ESP_OK(dsps_fft_plan_exec_batch_fc32(&plan, batch, BATCH_FRAMES, frame_step, elem_step));
+            TEST_ESP_OK(dsps_fft_plan_bit_rev_batch_fc32(&plan, batch, BATCH_FRAMES, frame_step, elem_step));
+
+            float max_err = 0;
+            for (int k = 0 ; k < BATCH_FRAMES ; k++) {
+                fill_frame(check, N, k);
+                TEST_ESP_OK(dsps_fft_plan_exec_fc32(&plan, check));
+                TEST_ESP_OK(dsps_fft_plan_bit_rev_fc32(&plan, check));
+                copy_frame(batch, frame, N, k, frame_step, elem_step, 0);
+                for (int i = 0 ; i < N * 2 ; i++) {
+                    max_err = fmaxf(max_err, fabsf(frame[i] - check[i]));
+                }
+            }
+            ESP_LOGI(TAG, "N = %i, radix %i, frame_step %i, elem_step %i, max error %e", N, plan.radix, frame_step, elem_step, max_err);
+            if (max_err > 1e-3) {
+                TEST_ASSERT_MESSAGE(false, "Result out of range!");
+            }
+        }
+        dsps_fft_plan_free(&plan);
+    }
+
+    dsps_fft_plan_t plan;
+    TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan, 64, 2, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_fft_plan_exec_batch_fc32(&plan, batch, 0, 64, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_fft_plan_bit_rev_batch_fc32(&plan, batch, 4, 1, 0));
+    dsps_fft_plan_free(&plan);
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fft_plan_exec_batch_fc32(&plan, batch, 4, 64, 1));
+
+    free(batch);
+    free(frame);
+    free(check);
+}
+
+TEST_CASE("dsps_fft_plan_exec_batch_fc32 benchmark", "[dsps]")
+{
+    const int frames = 8;
+    float *batch = (float *)memalign(16, 2 * frames * BATCH_MAX_N * sizeof(float));
+    TEST_ASSERT_NOT_NULL(batch);
+
+    // N, radix
+    const int configs[][2] = {{256, 2}, {512, 2}, {256, 4}};
+    for (int c = 0 ; c < sizeof(configs) / sizeof(configs[0]) ; c++) {
+        int N = configs[c][0];
+        dsps_fft_plan_t plan;
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan, N, configs[c][1], NULL));
+        for (int k = 0 ; k < frames ; k++) {
+            fill_frame(&batch[2 * k * N], N, k);
+        }
+
+        // The same ANSI C butterflies, one call per frame
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        for (int k = 0 ; k < frames ; k++) {
+            if (plan.radix == 4) {
+                dsps_fft4r_fc32_ansi_(&batch[2 * k * N], N, plan.w, plan.w_size);
+            } else {
+                dsps_fft2r_fc32_ansi_(&batch[2 * k * N], N, plan.w);
+            }
+        }
+        unsigned int end_b = dsp_get_cpu_cycle_count();
+        int cycles_single_ansi = (end_b - start_b) / frames;
+
+        start_b = dsp_get_cpu_cycle_count();
+        for (int k = 0 ; k < frames ; k++) {
+            dsps_fft_plan_exec_fc32(&plan, &batch[2 * k * N]);
+        }
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_single = (end_b - start_b) / frames;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft_plan_exec_batch_fc32(&plan, batch, frames, N, 1);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_contiguous = (end_b - start_b) / frames;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft_plan_exec_batch_fc32(&plan, batch, frames, 1, frames);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_interleaved = (end_b - start_b) / frames;
+
+        ESP_LOGI(TAG, "Benchmark %i frames of %i points, radix %i, cycles per frame: single ANSI calls %i, single optimized calls %i, contiguous batch %i, interleaved batch %i",
+                 frames, N, plan.radix, cycles_single_ansi, cycles_single, cycles_contiguous, cycles_interleaved);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_contiguous);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_interleaved);
+        dsps_fft_plan_free(&plan);
+    }
+    free(batch);
+}
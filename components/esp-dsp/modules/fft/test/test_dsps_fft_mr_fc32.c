@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_fft_mr.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fft_mr";
+
+static void fill_test_data(float *data, int N)
+{
+    for (int i = 0 ; i < N ; i++) {
+        data[i * 2 + 0] = sinf(2 * M_PI * 7 * i / N) + 0.5f * cosf(2 * M_PI * 0.37f * i) + 0.01f * (i % 7);
+        data[i * 2 + 1] = 0.25f * sinf(2 * M_PI * 3 * i / N);
+    }
+}
+
+// Direct DFT in double precision
+static float check_dft(const float *input, const float *result, int N)
+{
+    float max_err = 0;
+    for (int k = 0 ; k < N ; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0 ; n < N ; n++) {
+            double angle = -2 * M_PI * (double)((long)k * n % N) / N;
+            re += input[n * 2 + 0] * cos(angle) - input[n * 2 + 1] * sin(angle);
+            im += input[n * 2 + 0] * sin(angle) + input[n * 2 + 1] * cos(angle);
+        }
+        float err = fabsf((float)re - result[k * 2 + 0]) + fabsf((float)im - result[k * 2 + 1]);
+        if (err > max_err) {
+            max_err = err;
+        }
+    }
+    return max_err;
+}
+
+TEST_CASE("dsps_fft_mr_fc32 functionality", "[dsps]")
+{
+    // Speech frame sizes, pure radix-3/5 sizes, and powers of two
+    const int sizes[] = {400, 480, 320, 160, 240, 15, 75, 2, 64, 512};
+    float *input = (float *)memalign(16, 2 * 512 * sizeof(float));
+    float *data = (float *)memalign(16, 2 * 512 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(data);
+
+    for (int s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+        int N = sizes[s];
+        dsps_fft_mr_plan_t plan;
+        TEST_ESP_OK(dsps_fft_mr_plan_init_fc32(&plan, N));
+        fill_test_data(input, N);
+
+        memcpy(data, input, 2 * N * sizeof(float));
+        TEST_ESP_OK(dsps_fft_mr_fc32_ansi(&plan, data));
+        float err_ansi = check_dft(input, data, N);
+
+        memcpy(data, input, 2 * N * sizeof(float));
+        TEST_ESP_OK(dsps_fft_mr_fc32(&plan, data));
+        float err = check_dft(input, data, N);
+
+        ESP_LOGI(TAG, "N = %3i = %3i * %3i, max error ansi %f, optimized %f", N, plan.P, plan.Q, err_ansi, err);
+        if ((err_ansi > 1e-5 * N + 1e-4) || (err > 1e-5 * N + 1e-4)) {
+            TEST_ASSERT_MESSAGE(false, "Result out of range!");
+        }
+        dsps_fft_mr_plan_free(&plan);
+    }
+
+    // Power of two size gives the same result as dsps_fft2r_fc32_ansi
+    const int N = 512;
+    dsps_fft_mr_plan_t plan;
+    TEST_ESP_OK(dsps_fft_mr_plan_init_fc32(&plan, N));
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+    fill_test_data(input, N);
+    fill_test_data(data, N);
+    TEST_ESP_OK(dsps_fft_mr_fc32_ansi(&plan, input));
+    TEST_ESP_OK(dsps_fft2r_fc32_ansi(data, N));
+    TEST_ESP_OK(dsps_bit_rev_fc32_ansi(data, N));
+    for (int i = 0 ; i < N * 2 ; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, data[i], input[i]);
+    }
+    dsps_fft2r_deinit_fc32();
+    dsps_fft_mr_plan_free(&plan);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft_mr_plan_init_fc32(&plan, 7 * 64));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft_mr_plan_init_fc32(&plan, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fft_mr_fc32(&plan, data));
+    free(input);
+    free(data);
+}
+
+TEST_CASE("dsps_fft_mr_fc32 benchmark", "[dsps]")
+{
+    float *data = (float *)memalign(16, 2 * 512 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE));
+
+    // Zero padded 512 points FFT as a reference only: the mixed radix FFT is not expected
+    // to be faster for 400 or 480 points, so the cycles are logged and not compared
+    fill_test_data(data, 512);
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_fft2r_fc32_ansi(data, 512);
+    dsps_bit_rev_fc32_ansi(data, 512);
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    int cycles_r2 = end_b - start_b;
+
+    const int sizes[] = {400, 480, 320, 512};
+    for (int s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+        int N = sizes[s];
+        dsps_fft_mr_plan_t plan;
+        TEST_ESP_OK(dsps_fft_mr_plan_init_fc32(&plan, N));
+        fill_test_data(data, N);
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft_mr_fc32_ansi(&plan, data);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_ansi = end_b - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft_mr_fc32(&plan, data);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_opt = end_b - start_b;
+
+        ESP_LOGI(TAG, "Benchmark %3i points: dsps_fft_mr_fc32_ansi %6i, dsps_fft_mr_fc32 %6i cycles, 512 points dsps_fft2r_fc32_ansi %6i cycles",
+                 N, cycles_ansi, cycles_opt, cycles_r2);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_ansi);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_opt);
+        dsps_fft_mr_plan_free(&plan);
+    }
+    dsps_fft2r_deinit_fc32();
+    free(data);
+}
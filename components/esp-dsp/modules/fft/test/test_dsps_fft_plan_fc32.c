@@ -0,0 +1,164 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_fft_plan.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fft_plan";
+
+static void fill_test_data(float *data, int N)
+{
+    for (int i = 0 ; i < N ; i++) {
+        data[i * 2 + 0] = sinf(2 * M_PI * 5 * i / N) + 0.5f * cosf(2 * M_PI * 17 * i / N) + 0.01f * (i % 7);
+        data[i * 2 + 1] = 0.25f * sinf(2 * M_PI * 3 * i / N);
+    }
+}
+
+// Direct DFT in double precision
+static float check_dft(const float *input, const float *result, int N)
+{
+    float max_err = 0;
+    for (int k = 0 ; k < N ; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0 ; n < N ; n++) {
+            double angle = -2 * M_PI * (double)((long)k * n % N) / N;
+            re += input[n * 2 + 0] * cos(angle) - input[n * 2 + 1] * sin(angle);
+            im += input[n * 2 + 0] * sin(angle) + input[n * 2 + 1] * cos(angle);
+        }
+        float err = fabsf((float)re - result[k * 2 + 0]) + fabsf((float)im - result[k * 2 + 1]);
+        if (err > max_err) {
+            max_err = err;
+        }
+    }
+    return max_err;
+}
+
+TEST_CASE("dsps_fft_plan_fc32 functionality", "[dsps]")
+{
+    // Plans of different sizes and radixes are used together, without dsps_fft2r_init_fc32()
+    const int sizes[] = {8, 64, 256, 1024};
+    dsps_fft_plan_t plan_r2[4];
+    dsps_fft_plan_t plan_r4[4];
+    for (int p = 0 ; p < 4 ; p++) {
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan_r2[p], sizes[p], 2, NULL));
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan_r4[p], sizes[p], 4, NULL));
+    }
+
+    float *input = (float *)memalign(16, 2 * 1024 * sizeof(float));
+    float *data = (float *)memalign(16, 2 * 1024 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(data);
+
+    for (int p = 3 ; p >= 0 ; p--) {
+        int N = sizes[p];
+        fill_test_data(input, N);
+        for (int r = 0 ; r < 2 ; r++) {
+            dsps_fft_plan_t *plan = r ? &plan_r4[p] : &plan_r2[p];
+            memcpy(data, input, 2 * N * sizeof(float));
+            esp_err_t ret = dsps_fft_plan_exec_fc32(plan, data);
+            if ((plan->radix == 4) && (dsp_power_of_two(N) & 1)) {
+                TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, ret);
+                continue;
+            }
+            TEST_ESP_OK(ret);
+            TEST_ESP_OK(dsps_fft_plan_bit_rev_fc32(plan, data));
+            float err = check_dft(input, data, N);
+            ESP_LOGI(TAG, "N = %4i, radix %i, max error %f", N, plan->radix, err);
+            if (err > 1e-5 * N + 1e-4) {
+                TEST_ASSERT_MESSAGE(false, "Result out of range!");
+            }
+        }
+    }
+
+    for (int p = 0 ; p < 4 ; p++) {
+        dsps_fft_plan_free(&plan_r2[p]);
+        dsps_fft_plan_free(&plan_r4[p]);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fft_plan_exec_fc32(&plan_r2[0], data));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fft_plan_init_fc32(&plan_r2[0], 100, 2, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_fft_plan_init_fc32(&plan_r2[0], 64, 3, NULL));
+    free(input);
+    free(data);
+}
+
+TEST_CASE("dsps_fft_plan_fc32 matches global tables", "[dsps]")
+{
+    // dsps_fft2r_init_fc32() and dsps_fft4r_init_fc32() are built on a plan, results must be bit exact
+    const int N = 1024;
+    float *data = (float *)memalign(16, 2 * N * sizeof(float));
+    float *check_data = (float *)memalign(16, 2 * N * sizeof(float));
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(check_data);
+
+    for (int r = 2 ; r <= 4 ; r += 2) {
+        dsps_fft_plan_t plan;
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan, N, r, NULL));
+        fill_test_data(data, N);
+        memcpy(check_data, data, 2 * N * sizeof(float));
+        TEST_ESP_OK(dsps_fft_plan_exec_fc32(&plan, data));
+        TEST_ESP_OK(dsps_fft_plan_bit_rev_fc32(&plan, data));
+        if (r == 2) {
+            TEST_ESP_OK(dsps_fft2r_init_fc32(NULL, N));
+            TEST_ESP_OK(dsps_fft2r_fc32(check_data, N));
+            TEST_ESP_OK(dsps_bit_rev2r_fc32(check_data, N));
+            dsps_fft2r_deinit_fc32();
+        } else {
+            TEST_ESP_OK(dsps_fft4r_init_fc32(NULL, N));
+            TEST_ESP_OK(dsps_fft4r_fc32(check_data, N));
+            TEST_ESP_OK(dsps_bit_rev4r_fc32(check_data, N));
+            dsps_fft4r_deinit_fc32();
+        }
+        dsps_fft_plan_free(&plan);
+        for (int i = 0 ; i < N * 2 ; i++) {
+            TEST_ASSERT_EQUAL(check_data[i], data[i]);
+        }
+    }
+    // The kernels check the table, not the global init state
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fft2r_fc32_ansi(data, N));
+    free(data);
+    free(check_data);
+}
+
+TEST_CASE("dsps_fft_plan_fc32 benchmark", "[dsps]")
+{
+    float *data = (float *)memalign(16, 2 * 1024 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(data);
+
+    for (int N = 64 ; N <= 1024 ; N <<= 2) {
+        dsps_fft_plan_t plan_r2;
+        dsps_fft_plan_t plan_r4;
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan_r2, N, 2, NULL));
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&plan_r4, N, 4, NULL));
+        fill_test_data(data, N);
+
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_fft_plan_exec_fc32(&plan_r2, data);
+        dsps_fft_plan_bit_rev_fc32(&plan_r2, data);
+        unsigned int end_b = dsp_get_cpu_cycle_count();
+        int cycles_r2 = end_b - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft_plan_exec_fc32(&plan_r4, data);
+        dsps_fft_plan_bit_rev_fc32(&plan_r4, data);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_r4 = end_b - start_b;
+
+        ESP_LOGI(TAG, "Benchmark plan FFT with bit reverse - radix-2 %6i, radix-4 %6i cycles for %6i points FFT.", cycles_r2, cycles_r4, N);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_r2);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_r4);
+        dsps_fft_plan_free(&plan_r2);
+        dsps_fft_plan_free(&plan_r4);
+    }
+    free(data);
+}
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_rfft.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_rfft";
+
+static void fill_real_data(float *data, int N)
+{
+    for (int i = 0 ; i < N ; i++) {
+        data[i] = sinf(2 * M_PI * 3 * i / N) + 0.5f * cosf(2 * M_PI * (N / 4 - 1) * i / N) + 0.01f * (i % 5) - 0.25f;
+    }
+}
+
+// Half spectrum of the real input by direct DFT in double precision
+static float check_rdft(const float *input, const float *result, int N)
+{
+    float max_err = 0;
+    for (int k = 0 ; k <= N / 2 ; k++) {
+        double re = 0;
+        double im = 0;
+        for (int n = 0 ; n < N ; n++) {
+            double angle = -2 * M_PI * (double)((long)k * n % N) / N;
+            re += input[n] * cos(angle);
+            im += input[n] * sin(angle);
+        }
+        float err = fabsf((float)re - result[k * 2 + 0]) + fabsf((float)im - result[k * 2 + 1]);
+        if (err > max_err) {
+            max_err = err;
+        }
+    }
+    return max_err;
+}
+
+typedef esp_err_t (*rfft_func_t)(const dsps_rfft_plan_t *plan, float *data);
+
+static void test_rfft(rfft_func_t rfft, rfft_func_t irfft, const char *name)
+{
+    float *input = (float *)memalign(16, (2048 + 2) * sizeof(float));
+    float *data = (float *)memalign(16, (2048 + 2) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(data);
+
+    // N/2 of 256 and 1024 is not a power of four and uses the radix-2 kernel
+    for (int N = 8 ; N <= 2048 ; N <<= 1) {
+        dsps_rfft_plan_t plan;
+        TEST_ESP_OK(dsps_rfft_plan_init_fc32(&plan, N));
+        fill_real_data(input, N);
+        memcpy(data, input, N * sizeof(float));
+
+        TEST_ESP_OK(rfft(&plan, data));
+        float err = check_rdft(input, data, N);
+        TEST_ASSERT_EQUAL(0, data[1]);
+        TEST_ASSERT_EQUAL(0, data[N + 1]);
+
+        TEST_ESP_OK(irfft(&plan, data));
+        float rec_err = 0;
+        for (int i = 0 ; i < N ; i++) {
+            rec_err = fmaxf(rec_err, fabsf(data[i] - input[i]));
+        }
+        ESP_LOGI(TAG, "%s N = %4i, radix %i, spectrum error %f, reconstruction error %e", name, N, plan.fft.radix, err, rec_err);
+        if (err > 2e-6 * N + 1e-4) {
+            TEST_ASSERT_MESSAGE(false, "Spectrum out of range!");
+        }
+        if (rec_err > 1e-5) {
+            TEST_ASSERT_MESSAGE(false, "Reconstruction out of range!");
+        }
+        dsps_rfft_plan_free(&plan);
+    }
+    free(input);
+    free(data);
+}
+
+TEST_CASE("dsps_rfft_fc32_ansi functionality", "[dsps]")
+{
+    test_rfft(dsps_rfft_fc32_ansi, dsps_irfft_fc32_ansi, "ansi");
+
+    dsps_rfft_plan_t plan;
+    float data[10];
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_rfft_plan_init_fc32(&plan, 4));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_rfft_plan_init_fc32(&plan, 400));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_rfft_fc32_ansi(&plan, data));
+}
+
+TEST_CASE("dsps_rfft_fc32 functionality", "[dsps]")
+{
+    test_rfft(dsps_rfft_fc32, dsps_irfft_fc32, "optimized");
+}
+
+TEST_CASE("dsps_rfft_fc32 benchmark", "[dsps]")
+{
+    float *data = (float *)memalign(16, (2048 + 2) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(data);
+
+    for (int N = 256 ; N <= 2048 ; N <<= 1) {
+        dsps_rfft_plan_t plan;
+        dsps_fft_plan_t cplx_plan;
+        TEST_ESP_OK(dsps_rfft_plan_init_fc32(&plan, N));
+        TEST_ESP_OK(dsps_fft_plan_init_fc32(&cplx_plan, N, 2, NULL));
+        fill_real_data(data, N);
+
+        unsigned int start_b = dsp_get_cpu_cycle_count();
+        dsps_rfft_fc32(&plan, data);
+        unsigned int end_b = dsp_get_cpu_cycle_count();
+        int cycles_rfft = end_b - start_b;
+
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_irfft_fc32(&plan, data);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_irfft = end_b - start_b;
+
+        // Real input through the complex FFT of the same length, for comparison
+        float *cplx = (float *)memalign(16, 2 * N * sizeof(float));
+        TEST_ASSERT_NOT_NULL(cplx);
+        memset(cplx, 0, 2 * N * sizeof(float));
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fft_plan_exec_fc32(&cplx_plan, cplx);
+        dsps_fft_plan_bit_rev_fc32(&cplx_plan, cplx);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_cplx = end_b - start_b;
+        free(cplx);
+
+        ESP_LOGI(TAG, "Benchmark dsps_rfft_fc32 - %6i cycles, dsps_irfft_fc32 - %6i cycles, complex FFT - %6i cycles for %6i real points.", cycles_rfft, cycles_irfft, cycles_cplx, N);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_rfft);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_irfft);
+        dsps_rfft_plan_free(&plan);
+        dsps_fft_plan_free(&cplx_plan);
+    }
+    free(data);
+}
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+#include <malloc.h>
+
+#include "dsps_stft.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_stft";
+
+#define STFT_TEST_LEN 4000
+
+static void stft_count_frames(float *spectrum, int N, void *arg)
+{
+    (*(int *)arg)++;
+}
+
+static void stft_keep_spectrum(float *spectrum, int N, void *arg)
+{
+    memcpy(arg, spectrum, (N + 2) * sizeof(float));
+}
+
+TEST_CASE("dsps_stft_f32 functionality", "[dsps]")
+{
+    // frame, hop, FFT length, window
+    const int configs[][4] = {
+        {512, 256, 512, 0},
+        {512, 128, 512, 1},
+        {400, 160, 512, 0},
+        {256, 100, 256, 1},
+        {64, 64, 64, 2},
+    };
+    float *input = (float *)malloc(STFT_TEST_LEN * sizeof(float));
+    float *output = (float *)malloc(STFT_TEST_LEN * sizeof(float));
+    float *window = (float *)malloc(512 * sizeof(float));
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(output);
+    TEST_ASSERT_NOT_NULL(window);
+    for (int i = 0 ; i < STFT_TEST_LEN ; i++) {
+        input[i] = (float)rand() / (float)RAND_MAX - 0.5f;
+    }
+
+    for (int c = 0 ; c < sizeof(configs) / sizeof(configs[0]) ; c++) {
+        int frame_len = configs[c][0];
+        int hop = configs[c][1];
+        float *wind = NULL;
+        if (configs[c][3] == 1) {
+            dsps_wind_blackman_f32(window, frame_len);
+            wind = window;
+        } else if (configs[c][3] == 2) {
+            for (int i = 0 ; i < frame_len ; i++) {
+                window[i] = 1;
+            }
+            wind = window;
+        }
+        dsps_stft_t stft;
+        TEST_ESP_OK(dsps_stft_init_f32(&stft, frame_len, hop, configs[c][2], wind));
+
+        // Arbitrary push sizes, in place
+        memcpy(output, input, STFT_TEST_LEN * sizeof(float));
+        int frames = 0;
+        int pos = 0;
+        while (pos < STFT_TEST_LEN) {
+            int len = rand() % (2 * hop);
+            if (len > STFT_TEST_LEN - pos) {
+                len = STFT_TEST_LEN - pos;
+            }
+            TEST_ESP_OK(dsps_stft_process_f32(&stft, &output[pos], &output[pos], len, stft_count_frames, &frames));
+            pos += len;
+        }
+        TEST_ASSERT_EQUAL(STFT_TEST_LEN / hop, frames);
+
+        float max_err = 0;
+        for (int i = 0 ; i < STFT_TEST_LEN ; i++) {
+            float expected = (i < frame_len) ? 0 : input[i - frame_len];
+            max_err = fmaxf(max_err, fabsf(output[i] - expected));
+        }
+        ESP_LOGI(TAG, "frame %i, hop %i, FFT %i, reconstruction error %e", frame_len, hop, configs[c][2], max_err);
+        if (max_err > 1e-5) {
+            TEST_ASSERT_MESSAGE(false, "Reconstruction out of range!");
+        }
+        dsps_stft_free(&stft);
+    }
+
+    // Analysis and synthesis called separately give the same result
+    dsps_stft_t stft;
+    float *spectrum = (float *)memalign(16, (512 + 2) * sizeof(float));
+    TEST_ASSERT_NOT_NULL(spectrum);
+    TEST_ESP_OK(dsps_stft_init_f32(&stft, 512, 128, 512, NULL));
+    for (int pos = 0 ; pos < STFT_TEST_LEN - 128 ; pos += 128) {
+        TEST_ESP_OK(dsps_stft_f32(&stft, &input[pos], 128, stft_keep_spectrum, spectrum));
+        TEST_ESP_OK(dsps_istft_f32(&stft, spectrum, &output[pos]));
+    }
+    for (int i = 512 ; i < STFT_TEST_LEN - 128 - 384 ; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5, input[i], output[i + 384]);
+    }
+    dsps_stft_free(&stft);
+
+    // Hann window has zeros at both ends, it could not be used without overlap
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_PARAM, dsps_stft_init_f32(&stft, 256, 256, 256, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_stft_init_f32(&stft, 256, 300, 256, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_stft_init_f32(&stft, 400, 160, 256, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_stft_process_f32(&stft, input, output, 16, NULL, NULL));
+
+    free(input);
+    free(output);
+    free(window);
+    free(spectrum);
+}
+
+TEST_CASE("dsps_stft_f32 benchmark", "[dsps]")
+{
+    const int frame_len = 512;
+    const int hop = 128;
+    const int repeat_count = 16;
+    float *input = (float *)malloc(hop * sizeof(float));
+    float *output = (float *)malloc(hop * sizeof(float));
+    TEST_ASSERT_NOT_NULL(input);
+    TEST_ASSERT_NOT_NULL(output);
+    for (int i = 0 ; i < hop ; i++) {
+        input[i] = sinf(2 * M_PI * 7 * i / hop);
+    }
+    dsps_stft_t stft;
+    TEST_ESP_OK(dsps_stft_init_f32(&stft, frame_len, hop, frame_len, NULL));
+    int frames = 0;
+
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_stft_f32(&stft, input, hop, stft_count_frames, &frames);
+    }
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    float cycles_stft = (float)(end_b - start_b) / repeat_count;
+
+    start_b = dsp_get_cpu_cycle_count();
+    for (int i = 0 ; i < repeat_count ; i++) {
+        dsps_stft_process_f32(&stft, input, output, hop, NULL, NULL);
+    }
+    end_b = dsp_get_cpu_cycle_count();
+    float cycles_process = (float)(end_b - start_b) / repeat_count;
+
+    ESP_LOGI(TAG, "Benchmark frame %i, hop %i: analysis %f cycles per frame, analysis and synthesis %f cycles per frame", frame_len, hop, cycles_stft, cycles_process);
+    TEST_ASSERT_EQUAL(repeat_count, frames);
+    TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_stft);
+    TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, cycles_process);
+
+    dsps_stft_free(&stft);
+    free(input);
+    free(output);
+}
@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "dsps_fir_fd.h"
+#include "dsp_common.h"
+#include "dsp_block_buff.h"
+#include <string.h>
+#include <malloc.h>
+
+esp_err_t dsps_fir_fd_init_f32(fir_fd_f32_t *fir, const float *coeffs, int coeffs_len, int block_len)
+{
+    memset(fir, 0, sizeof(fir_fd_f32_t));
+    if ((coeffs == NULL) || (coeffs_len <= 0) || (block_len < 4) || !dsp_is_power_of_two(block_len)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    int fft_len = 2 * block_len;
+    esp_err_t result = dsps_rfft_plan_init_fc32(&fir->plan, fft_len);
+    if (result != ESP_OK) {
+        return result;
+    }
+    int parts = (coeffs_len + block_len - 1) / block_len;
+    // Both spectra arrays hold parts spectra of part_size floats each
+    int part_size = DSP_BLOCK_BUFF_SIZE(fft_len + 2);
+    int total = (2 * parts + 1) * part_size + DSP_BLOCK_BUFF_SIZE(fft_len) + DSP_BLOCK_BUFF_SIZE(block_len);
+    float *mem = (float *)memalign(16, total * sizeof(float));
+    if (mem == NULL) {
+        dsps_rfft_plan_free(&fir->plan);
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    memset(mem, 0, total * sizeof(float));
+    fir->coeffs_fft = dsp_block_buff_carve(&mem, parts * part_size);
+    fir->fdl = dsp_block_buff_carve(&mem, parts * part_size);
+    fir->acc = dsp_block_buff_carve(&mem, fft_len + 2);
+    fir->in_buff = dsp_block_buff_carve(&mem, fft_len);
+    fir->out_buff = dsp_block_buff_carve(&mem, block_len);
+    fir->N = coeffs_len;
+    fir->block_len = block_len;
+    fir->parts = parts;
+    fir->part_size = part_size;
+
+    // dsps_fir_f32() applies coeffs[0] to the oldest sample, so the impulse response is the reversed array.
+    // Every partition of block_len taps of the impulse response is zero padded to the FFT length.
+    for (int p = 0; p < parts; p++) {
+        float *spectrum = &fir->coeffs_fft[p * part_size];
+        for (int i = 0; (i < block_len) && (p * block_len + i < coeffs_len); i++) {
+            spectrum[i] = coeffs[coeffs_len - 1 - p * block_len - i];
+        }
+        result = dsps_rfft_fc32(&fir->plan, spectrum);
+        if (result != ESP_OK) {
+            dsps_fir_fd_f32_free(fir);
+            return result;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t dsps_fir_fd_f32_free(fir_fd_f32_t *fir)
+{
+    dsps_rfft_plan_free(&fir->plan);
+    free(fir->coeffs_fft);
+    memset(fir, 0, sizeof(fir_fd_f32_t));
+    return ESP_OK;
+}
+
+// acc += x * h for bins complex values
+static void dsps_fir_fd_cmac(float *acc, const float *x, const float *h, int bins)
+{
+    for (int k = 0; k < bins; k++) {
+        acc[2 * k + 0] += x[2 * k + 0] * h[2 * k + 0] - x[2 * k + 1] * h[2 * k + 1];
+        acc[2 * k + 1] += x[2 * k + 0] * h[2 * k + 1] + x[2 * k + 1] * h[2 * k + 0];
+    }
+}
+
+// Filters the block in in_buff, the result goes to out_buff
+static esp_err_t dsps_fir_fd_block(void *arg)
+{
+    fir_fd_f32_t *fir = (fir_fd_f32_t *)arg;
+    int B = fir->block_len;
+    int parts = fir->parts;
+    int part_size = fir->part_size;
+    fir->fdl_pos = (fir->fdl_pos == 0 ? parts : fir->fdl_pos) - 1;
+    float *x = &fir->fdl[fir->fdl_pos * part_size];
+    memcpy(x, fir->in_buff, 2 * B * sizeof(float));
+    esp_err_t result = dsps_rfft_fc32(&fir->plan, x);
+    if (result != ESP_OK) {
+        return result;
+    }
+    // Partition p of the coefficients is multiplied by the spectrum of the input block p blocks ago.
+    // The delay line is a ring: the older spectra follow the newest one and wrap around to the start.
+    memset(fir->acc, 0, (2 * B + 2) * sizeof(float));
+    int older = parts - fir->fdl_pos;
+    for (int p = 0; p < older; p++) {
+        dsps_fir_fd_cmac(fir->acc, &x[p * part_size], &fir->coeffs_fft[p * part_size], B + 1);
+    }
+    for (int p = older; p < parts; p++) {
+        dsps_fir_fd_cmac(fir->acc, &fir->fdl[(p - older) * part_size], &fir->coeffs_fft[p * part_size], B + 1);
+    }
+    result = dsps_irfft_fc32(&fir->plan, fir->acc);
+    if (result != ESP_OK) {
+        return result;
+    }
+    // The first half is the circular alias of the previous block
+    memcpy(fir->out_buff, &fir->acc[B], B * sizeof(float));
+    memcpy(fir->in_buff, &fir->in_buff[B], B * sizeof(float));
+    return ESP_OK;
+}
+
+esp_err_t dsps_fir_fd_f32(fir_fd_f32_t *fir, const float *input, float *output, int len)
+{
+    if (fir->in_buff == NULL) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    // The current block is the second half of in_buff
+    return dsp_block_buff_stream(input, output, len, &fir->in_buff[fir->block_len], fir->out_buff,
+                                 fir->block_len, &fir->pos, dsps_fir_fd_block, fir);
+}
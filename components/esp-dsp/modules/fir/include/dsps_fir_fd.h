@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _dsps_fir_fd_H_
+#define _dsps_fir_fd_H_
+
+#include "dsp_err.h"
+#include "dsps_rfft.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Data struct of f32 frequency domain fir filter
+ *
+ * Uniformly partitioned convolution: the coefficients are split into partitions of block_len taps,
+ * the spectrum of every partition is calculated once by the init function.
+ * Every block of block_len input samples is transformed with a real FFT of 2*block_len samples
+ * and stored in the frequency domain delay line. The output block is the inverse FFT of the sum of
+ * the delay line spectra multiplied by the partition spectra.
+ * The latency is block_len samples for any filter length, and the cost per sample grows
+ * with the number of partitions instead of the number of taps.
+ *
+ * This structure is used by a filter internally. A user should access this structure only in case of
+ * extensions for the DSP Library.
+ * All fields of this structure are initialized by the dsps_fir_fd_init_f32(...) function.
+ */
+typedef struct fir_fd_f32_s {
+    dsps_rfft_plan_t plan;  /*!< Real FFT plan of 2*block_len samples.*/
+    float  *coeffs_fft;     /*!< Spectra of the coefficient partitions.*/
+    float  *fdl;            /*!< Frequency domain delay line, spectra of the last input blocks.*/
+    float  *in_buff;        /*!< Previous and current input block, 2*block_len samples.*/
+    float  *out_buff;       /*!< Output of the previous block, block_len samples.*/
+    float  *acc;            /*!< Sum of the spectra and inverse FFT buffer.*/
+    int     N;              /*!< FIR filter coefficients amount.*/
+    int     block_len;      /*!< Number of samples per block.*/
+    int     parts;          /*!< Number of partitions.*/
+    int     part_size;      /*!< Size of one spectrum in the coeffs_fft and fdl arrays.*/
+    int     fdl_pos;        /*!< Partition of the newest spectrum in the delay line.*/
+    int     pos;            /*!< Number of samples of the current block.*/
+} fir_fd_f32_t;
+
+/**
+ * @brief   initialize structure for 32 bit frequency domain FIR filter
+ *
+ * Function initialize structure for 32 bit floating point partitioned frequency domain FIR filter.
+ * The coefficients are transformed to the frequency domain, so the coeffs array
+ * could be released after the call.
+ * The implementation use ANSI C and could be compiled and run on any platform
+ *
+ * @param fir: pointer to fir filter structure, that must be preallocated
+ * @param coeffs: array with FIR filter coefficients, in the same order as for dsps_fir_init_f32(). Must be length coeffs_len
+ * @param coeffs_len: FIR filter length
+ * @param block_len: partition and block size, power of two, at least 4. Defines the latency of the filter.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_INVALID_LENGTH if coeffs_len or block_len is not valid
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if memory allocation fails
+ */
+esp_err_t dsps_fir_fd_init_f32(fir_fd_f32_t *fir, const float *coeffs, int coeffs_len, int block_len);
+
+/**
+ * @brief   32 bit floating point frequency domain FIR filter
+ *
+ * Function implements FIR filter with the same result as dsps_fir_f32(), delayed by fir->block_len samples:
+ * the first block_len output samples after the init are 0.
+ * Any number of samples could be processed, the input and output arrays could be the same.
+ *
+ * @param fir: pointer to fir filter structure, that must be initialized before
+ * @param[in] input: input array
+ * @param[out] output: array with the result of FIR filter
+ * @param[in] len: length of input and result arrays
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_UNINITIALIZED if the structure is not initialized
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fir_fd_f32(fir_fd_f32_t *fir, const float *input, float *output, int len);
+
+/**
+ * @brief   support arrays freeing function
+ *
+ * Function frees all the arrays, which were allocated by the dsps_fir_fd_init_f32(...) function.
+ *
+ * @param fir: pointer to fir filter structure
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t dsps_fir_fd_f32_free(fir_fd_f32_t *fir);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fir_fd_H_
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <malloc.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dsps_fir.h"
+#include "dsps_fir_fd.h"
+#include "dsp_tests.h"
+
+static const char *TAG = "dsps_fir_fd_f32";
+
+#define FIR_FD_MAX_TAPS 2000
+#define FIR_FD_LEN 4096
+
+static void fill_random(float *data, int len, float scale)
+{
+    for (int i = 0 ; i < len ; i++) {
+        data[i] = scale * ((float)rand() / (float)RAND_MAX - 0.5f);
+    }
+}
+
+TEST_CASE("dsps_fir_fd_f32 functionality", "[dsps]")
+{
+    float *coeffs = (float *)memalign(16, FIR_FD_MAX_TAPS * sizeof(float));
+    float *delay = (float *)memalign(16, (FIR_FD_MAX_TAPS + 4) * sizeof(float));
+    float *x = (float *)malloc(FIR_FD_LEN * sizeof(float));
+    float *y = (float *)malloc(FIR_FD_LEN * sizeof(float));
+    float *y_ref = (float *)malloc(FIR_FD_LEN * sizeof(float));
+    TEST_ASSERT_NOT_NULL(coeffs);
+    TEST_ASSERT_NOT_NULL(delay);
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    TEST_ASSERT_NOT_NULL(y_ref);
+
+    // Taps, block length: partial last partition, one partition, taps shorter than the block
+    const int configs[][2] = {{2000, 128}, {1000, 64}, {512, 512}, {20, 32}, {1, 4}};
+    for (int c = 0 ; c < sizeof(configs) / sizeof(configs[0]) ; c++) {
+        int taps = configs[c][0];
+        int block_len = configs[c][1];
+        fill_random(coeffs, taps, 2.0f / sqrtf(taps));
+        fill_random(x, FIR_FD_LEN, 2.0f);
+
+        fir_f32_t fir_ref;
+        TEST_ESP_OK(dsps_fir_init_f32(&fir_ref, coeffs, delay, taps));
+        TEST_ESP_OK(dsps_fir_f32_ansi(&fir_ref, x, y_ref, FIR_FD_LEN));
+
+        fir_fd_f32_t fir;
+        TEST_ESP_OK(dsps_fir_fd_init_f32(&fir, coeffs, taps, block_len));
+        // Chunks of different sizes, processed in place
+        memcpy(y, x, FIR_FD_LEN * sizeof(float));
+        for (int pos = 0, chunk = 1 ; pos < FIR_FD_LEN ; pos += chunk, chunk = chunk * 2 + 3) {
+            if (chunk > FIR_FD_LEN - pos) {
+                chunk = FIR_FD_LEN - pos;
+            }
+            TEST_ESP_OK(dsps_fir_fd_f32(&fir, &y[pos], &y[pos], chunk));
+        }
+        float max_err = 0;
+        for (int i = 0 ; i < FIR_FD_LEN ; i++) {
+            float ref = (i < block_len) ? 0 : y_ref[i - block_len];
+            max_err = fmaxf(max_err, fabsf(y[i] - ref));
+        }
+        ESP_LOGI(TAG, "taps %4i, block %3i, partitions %2i, max error %e", taps, block_len, fir.parts, max_err);
+        if (max_err > 1e-4) {
+            TEST_ASSERT_MESSAGE(false, "Result out of range!");
+        }
+        TEST_ESP_OK(dsps_fir_fd_f32_free(&fir));
+        TEST_ASSERT_EQUAL(ESP_ERR_DSP_UNINITIALIZED, dsps_fir_fd_f32(&fir, x, y, 1));
+    }
+
+    fir_fd_f32_t fir;
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fir_fd_init_f32(&fir, coeffs, 100, 100));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fir_fd_init_f32(&fir, coeffs, 100, 2));
+    TEST_ASSERT_EQUAL(ESP_ERR_DSP_INVALID_LENGTH, dsps_fir_fd_init_f32(&fir, coeffs, 0, 64));
+
+    free(coeffs);
+    free(delay);
+    free(x);
+    free(y);
+    free(y_ref);
+}
+
+TEST_CASE("dsps_fir_fd_f32 benchmark", "[dsps]")
+{
+    const int taps = 1024;
+    const int len = 1024;
+    float *coeffs = (float *)memalign(16, taps * sizeof(float));
+    float *delay = (float *)memalign(16, (taps + 4) * sizeof(float));
+    float *x = (float *)memalign(16, len * sizeof(float));
+    float *y = (float *)memalign(16, len * sizeof(float));
+    TEST_ASSERT_NOT_NULL(coeffs);
+    TEST_ASSERT_NOT_NULL(delay);
+    TEST_ASSERT_NOT_NULL(x);
+    TEST_ASSERT_NOT_NULL(y);
+    fill_random(coeffs, taps, 0.1f);
+    fill_random(x, len, 1.0f);
+
+    fir_f32_t fir_td;
+    TEST_ESP_OK(dsps_fir_init_f32(&fir_td, coeffs, delay, taps));
+    unsigned int start_b = dsp_get_cpu_cycle_count();
+    dsps_fir_f32(&fir_td, x, y, len);
+    unsigned int end_b = dsp_get_cpu_cycle_count();
+    int cycles_td = (end_b - start_b) / len;
+
+    for (int block_len = 64 ; block_len <= 256 ; block_len <<= 1) {
+        fir_fd_f32_t fir;
+        TEST_ESP_OK(dsps_fir_fd_init_f32(&fir, coeffs, taps, block_len));
+        start_b = dsp_get_cpu_cycle_count();
+        dsps_fir_fd_f32(&fir, x, y, len);
+        end_b = dsp_get_cpu_cycle_count();
+        int cycles_fd = (end_b - start_b) / len;
+
+        ESP_LOGI(TAG, "Benchmark %i taps, cycles per sample: dsps_fir_f32 %i, dsps_fir_fd_f32 block %i: %i",
+                 taps, cycles_td, block_len, cycles_fd);
+        TEST_ASSERT_EXEC_IN_RANGE(3, 330000 * 3, end_b - start_b);
+        TEST_ESP_OK(dsps_fir_fd_f32_free(&fir));
+    }
+    free(coeffs);
+    free(delay);
+    free(x);
+    free(y);
+}
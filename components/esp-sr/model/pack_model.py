@@ -1,7 +1,12 @@
 import os
 import struct
+import zlib
 import argparse
 
+PACK_MAGIC = b"SRMB"
+PACK_VERSION = 2
+PACK_PREFIX_LEN = 16  # magic, version, header_len, header_crc
+
 
 def struct_pack_string(string, max_len=None):
     """
@@ -38,14 +43,19 @@ def read_data(filename):
         data = f.read()
     return data
 
-def pack_models(model_path, out_file="srmodels.bin"):
+def pack_models(model_path, out_file="srmodels.bin", version=PACK_VERSION):
     """
     Pack all models into one binary file by the following format:
     {
+        magic: char[4] = "SRMB"           // version 2 and later only
+        version: int
+        header_len: int                   // bytes before the first file, data offsets are absolute
+        header_crc: int                   // crc32 of bytes [16, header_len)
         model_num: int
         model1_info: model_info_t
         model2_info: model_info_t
         ...
+        file_crc: int[file_num]           // crc32 of each file in table order, version 2 and later only
         model1_index,model1_data,model1_MODEL_INFO
         model1_index,model1_data,model1_MODEL_INFO
         ...
@@ -63,8 +73,11 @@ def pack_models(model_path, out_file="srmodels.bin"):
         ...
     }model_info_t
 
+    Version 1 packs are the bare table without prefix and CRCs.
+
     model_path: the path of models
     out_file: the ouput binary filename
+    version: pack format version, 1 or 2
     """
 
     models = {}
@@ -83,29 +96,33 @@ def pack_models(model_path, out_file="srmodels.bin"):
     
     model_num = len(models)
     header_len = 4 + model_num*(32+4) + file_num*(32+4+4) 
-    out_bin = struct.pack('I', model_num)  # model number
-    data_bin = None
+    if version >= 2:
+        header_len += PACK_PREFIX_LEN + file_num*4
+    table_bin = struct.pack('I', model_num)  # model number
+    crc_bin = b""
+    data_bin = b""
     for key in models:
         model_bin = struct_pack_string(key, 32) # + model name
         model_bin += struct.pack('I', len(models[key])) # + file number in this model
         
         for file_name in models[key]:
+            file_data = models[key][file_name]
             model_bin += struct_pack_string(file_name, 32) # + file name
-            if data_bin == None:
-                model_bin += struct.pack('I', header_len) 
-                data_bin = models[key][file_name]
-                model_bin += struct.pack('I', len(models[key][file_name]))
-                # print(file_name, header_len, len(models[key][file_name]), len(data_bin))
-            else:
-                model_bin += struct.pack('I', header_len+len(data_bin))
-                # print(file_name, header_len+len(data_bin), len(models[key][file_name]))
-                data_bin += models[key][file_name]
-                model_bin += struct.pack('I', len(models[key][file_name]))
+            model_bin += struct.pack('I', header_len+len(data_bin)) # + file start
+            model_bin += struct.pack('I', len(file_data)) # + file length
+            crc_bin += struct.pack('I', zlib.crc32(file_data) & 0xffffffff)
+            data_bin += file_data
         
-        out_bin += model_bin
+        table_bin += model_bin
+
+    if version >= 2:
+        table_bin += crc_bin
+        header_crc = zlib.crc32(table_bin) & 0xffffffff
+        out_bin = PACK_MAGIC + struct.pack('III', version, header_len, header_crc) + table_bin
+    else:
+        out_bin = table_bin
     assert len(out_bin) == header_len
-    if data_bin != None:
-        out_bin += data_bin
+    out_bin += data_bin
 
     out_file = os.path.join(model_path, out_file)
     with open(out_file, "wb") as f:
@@ -117,7 +134,9 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(description='Model package tool')
     parser.add_argument('-m', '--model_path', help="the path of model files")
     parser.add_argument('-o', '--out_file', default="srmodels.bin", help="the path of binary file")
+    parser.add_argument('-v', '--version', type=int, default=PACK_VERSION, choices=[1, PACK_VERSION],
+                        help="pack format version, 1 writes the legacy layout without checksums")
     args = parser.parse_args()
 
     # convert(args.model_path, args.out_file)
-    pack_models(model_path=args.model_path, out_file=args.out_file)
+    pack_models(model_path=args.model_path, out_file=args.out_file, version=args.version)
@@ -1,17 +1,87 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include "string.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_mn_speech_commands.h"
 #include "esp_mn_iface.h"
 #include "flite_g2p.h"
+#if CONFIG_SR_MN_G2P_CACHE
+#include <inttypes.h>
+#include "nvs.h"
+#endif
 
 static char *TAG = "MN_COMMAND";
 static esp_mn_node_t *esp_mn_root = NULL;
 const static esp_mn_iface_t *esp_mn_model_handle = NULL;
 static model_iface_data_t *esp_mn_model_data = NULL;
 
+// MultiNet consumes the linked list, these index it. esp_mn_nodes holds the nodes in list
+// order (position == phrase id) and esp_mn_slots is an open addressing hash of command strings.
+static esp_mn_node_t *esp_mn_tail = NULL;
+static esp_mn_node_t **esp_mn_nodes = NULL;
+static int esp_mn_nodes_num = 0;
+static int esp_mn_nodes_cap = 0;
+static esp_mn_node_t **esp_mn_slots = NULL;
+static uint32_t esp_mn_slots_mask = 0;
+static uint32_t esp_mn_slots_used = 0;                   // live entries and tombstones
+#define ESP_MN_SLOT_DELETED ((esp_mn_node_t *)&esp_mn_slots_mask)
+
+// Phrases, strings, phonemes and nodes of the list are bump allocated from PSRAM blocks and
+// only given back all at once. Removed and modified commands are counted as dead and copied
+// out of the arena by esp_mn_commands_update(), which moves the live ones to fresh blocks.
+typedef struct esp_mn_arena_block {
+    struct esp_mn_arena_block *next;
+    size_t size;
+    size_t used;
+    uint8_t data[] __attribute__((aligned(8)));
+} esp_mn_arena_block_t;
+
+typedef struct {
+    esp_mn_arena_block_t *head;                          // block being filled
+    size_t used;
+    size_t size;
+    size_t dead;                                         // part of used no command refers to
+} esp_mn_arena_t;
+#define ESP_MN_ARENA_BLOCK_SIZE (4 * 1024)
+static esp_mn_arena_t esp_mn_arena = {0};
+
+// Commands staged between esp_mn_commands_batch_begin() and esp_mn_commands_batch_commit()
+typedef struct {
+    int command_id;
+    char *string;
+    char *phonemes;                                      // from the caller
+    char *g2p;                                           // flite_g2p() result at commit, heap
+    bool invalid;                                        // skipped with ESP_MN_BATCH_SKIP_INVALID
+    bool g2p_cached;                                     // g2p came from the G2P cache
+} esp_mn_staged_t;
+static esp_mn_arena_t esp_mn_batch_arena = {0};
+static esp_mn_staged_t *esp_mn_batch = NULL;
+static int esp_mn_batch_num = 0;
+static int esp_mn_batch_cap = 0;
+static bool esp_mn_batch_open = false;
+static uint32_t esp_mn_batch_flags = 0;
+#define ESP_MN_G2P_TASK_STACK (8 * 1024)
+
+#if CONFIG_SR_MN_G2P_CACHE
+// Phonemes of earlier G2P runs, keyed by a hash of the G2P version and the command string.
+// The value holds the string too, so a hash collision is a miss rather than wrong phonemes.
+// The namespace is erased when it was written by another G2P version, and holds at most
+// CONFIG_SR_MN_G2P_CACHE_MAX_ENTRIES entries. Every entry has a u32 insertion sequence number
+// under its key prefixed with ESP_MN_G2P_SEQ_PREFIX, the lowest one is evicted to make room.
+#define ESP_MN_G2P_NVS_NAMESPACE "mn_g2p"
+#define ESP_MN_G2P_VERSION "flite_g2p " ESP_MN_G2P_LIB_HASH // MD5 of the linked libflite_g2p.a, from CMakeLists.txt
+#define ESP_MN_G2P_VERSION_KEY "version"                 // G2P version of the entries
+#define ESP_MN_G2P_COUNT_KEY "count"                     // number of entries
+#define ESP_MN_G2P_NEXT_SEQ_KEY "next"                   // sequence number of the next entry
+#define ESP_MN_G2P_SEQ_PREFIX 's'                        // not a hex digit, so it never starts an entry key
+#endif
+static uint32_t esp_mn_g2p_hits = 0;
+static uint32_t esp_mn_g2p_misses = 0;
+
 void *_esp_mn_calloc_(int n, int size)
 {
 #ifdef ESP_PLATFORM
@@ -31,12 +101,359 @@ void *_esp_mn_calloc_(int n, int size)
         }                                                                                       \
     } while(0)
 
+#define ESP_MN_ARENA_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+static void *esp_mn_arena_alloc(esp_mn_arena_t *arena, size_t size)
+{
+    size = ESP_MN_ARENA_ALIGN(size);
+    esp_mn_arena_block_t *block = arena->head;
+    if (block == NULL || block->size - block->used < size) {
+        size_t block_size = size > ESP_MN_ARENA_BLOCK_SIZE ? size : ESP_MN_ARENA_BLOCK_SIZE;
+        block = _esp_mn_calloc_(1, sizeof(esp_mn_arena_block_t) + block_size);
+        ESP_RETURN_ON_FALSE(NULL != block, NULL, TAG, "Fail to alloc command memory");
+        block->size = block_size;
+        block->next = arena->head;
+        arena->head = block;
+        arena->size += block_size;
+    }
+    void *data = block->data + block->used;
+    block->used += size;
+    arena->used += size;
+    return data;
+}
+
+static char *esp_mn_arena_strdup(esp_mn_arena_t *arena, const char *string)
+{
+    size_t len = strlen(string);
+    char *copy = esp_mn_arena_alloc(arena, len + 1);
+    if (copy) {
+        memcpy(copy, string, len + 1);
+    }
+    return copy;
+}
+
+static void esp_mn_arena_reset(esp_mn_arena_t *arena)
+{
+    while (arena->head) {
+        esp_mn_arena_block_t *block = arena->head;
+        arena->head = block->next;
+        free(block);
+    }
+    arena->used = 0;
+    arena->size = 0;
+    arena->dead = 0;
+}
+
+// Phrase with its strings in the list arena, wave stays on the heap
+static esp_mn_phrase_t *esp_mn_arena_phrase(int command_id, const char *string, const char *phonemes)
+{
+    ESP_RETURN_ON_FALSE(string[0] != '\0', NULL, TAG, "input string is empty");
+    esp_mn_phrase_t *phrase = esp_mn_arena_alloc(&esp_mn_arena, sizeof(esp_mn_phrase_t));
+    if (phrase == NULL) {
+        return NULL;
+    }
+    phrase->string = esp_mn_arena_strdup(&esp_mn_arena, string);
+    phrase->phonemes = phonemes ? esp_mn_arena_strdup(&esp_mn_arena, phonemes) : NULL;
+    if (phrase->string == NULL || (phonemes && phrase->phonemes == NULL)) {
+        return NULL;
+    }
+    phrase->command_id = command_id;
+    phrase->threshold = 0;
+    phrase->wave = NULL;
+    return phrase;
+}
+
+// Arena bytes of a phrase made by esp_mn_arena_phrase()
+static size_t esp_mn_arena_phrase_size(const esp_mn_phrase_t *phrase)
+{
+    size_t size = ESP_MN_ARENA_ALIGN(sizeof(esp_mn_phrase_t)) + ESP_MN_ARENA_ALIGN(strlen(phrase->string) + 1);
+    if (phrase->phonemes) {
+        size += ESP_MN_ARENA_ALIGN(strlen(phrase->phonemes) + 1);
+    }
+    return size;
+}
+
+static uint32_t esp_mn_hash_from(uint32_t h, const char *string)
+{
+    while (*string) {
+        h ^= (uint8_t)*string++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t esp_mn_hash(const char *string)
+{
+    return esp_mn_hash_from(2166136261u, string);
+}
+
+#if CONFIG_SR_MN_G2P_CACHE
+static void esp_mn_g2p_key(const char *string, char key[NVS_KEY_NAME_MAX_SIZE])
+{
+    uint32_t h = esp_mn_hash_from(esp_mn_hash(ESP_MN_G2P_VERSION), string);
+    snprintf(key, NVS_KEY_NAME_MAX_SIZE, "%08" PRIx32, h);
+}
+
+static void esp_mn_g2p_seq_key(const char *key, char seq_key[NVS_KEY_NAME_MAX_SIZE])
+{
+    snprintf(seq_key, NVS_KEY_NAME_MAX_SIZE, "%c%s", ESP_MN_G2P_SEQ_PREFIX, key);
+}
+
+// Erase every entry and stamp the namespace with the current G2P version
+static esp_err_t esp_mn_g2p_cache_reset(nvs_handle_t nvs)
+{
+    esp_err_t err = nvs_erase_all(nvs);
+    if (err == ESP_OK) {
+        err = nvs_set_str(nvs, ESP_MN_G2P_VERSION_KEY, ESP_MN_G2P_VERSION);
+    }
+    if (err == ESP_OK) {
+        err = nvs_set_u32(nvs, ESP_MN_G2P_COUNT_KEY, 0);
+    }
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs);
+    }
+    return err;
+}
+
+// Open the cache, entries of another G2P version are dropped
+static esp_err_t esp_mn_g2p_cache_open(nvs_handle_t *nvs)
+{
+    esp_err_t err = nvs_open(ESP_MN_G2P_NVS_NAMESPACE, NVS_READWRITE, nvs);
+    if (err != ESP_OK) {
+        return err;
+    }
+    char version[sizeof(ESP_MN_G2P_VERSION)];
+    size_t size = sizeof(version);
+    if (nvs_get_str(*nvs, ESP_MN_G2P_VERSION_KEY, version, &size) != ESP_OK || strcmp(version, ESP_MN_G2P_VERSION) != 0) {
+        ESP_LOGI(TAG, "G2P cache: new G2P version, cache erased");
+        err = esp_mn_g2p_cache_reset(*nvs);
+        if (err != ESP_OK) {
+            nvs_close(*nvs);
+        }
+    }
+    return err;
+}
+
+// Erase the entry with the lowest sequence number, NVS does not list entries in insertion order
+static esp_err_t esp_mn_g2p_cache_evict(nvs_handle_t nvs)
+{
+    char oldest[NVS_KEY_NAME_MAX_SIZE] = {0};
+    uint32_t oldest_seq = UINT32_MAX;
+    nvs_iterator_t it = NULL;
+    esp_err_t err = nvs_entry_find(NVS_DEFAULT_PART_NAME, ESP_MN_G2P_NVS_NAMESPACE, NVS_TYPE_U32, &it);
+    while (err == ESP_OK) {
+        nvs_entry_info_t info;
+        uint32_t seq;
+        if (nvs_entry_info(it, &info) == ESP_OK && info.key[0] == ESP_MN_G2P_SEQ_PREFIX &&
+                nvs_get_u32(nvs, info.key, &seq) == ESP_OK && seq <= oldest_seq) {
+            oldest_seq = seq;
+            memcpy(oldest, info.key, sizeof(oldest));
+        }
+        err = nvs_entry_next(&it);
+    }
+    nvs_release_iterator(it);
+    if (oldest[0] == '\0') {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    err = nvs_erase_key(nvs, oldest + 1);
+    if (err == ESP_OK || err == ESP_ERR_NVS_NOT_FOUND) {
+        err = nvs_erase_key(nvs, oldest);
+    }
+    return err;
+}
+
+// Cached phonemes of string, heap allocated like flite_g2p() results, or NULL
+static char *esp_mn_g2p_cache_get(nvs_handle_t nvs, const char *string)
+{
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    esp_mn_g2p_key(string, key);
+    size_t len = strlen(string) + 1;
+    size_t size = 0;
+    if (nvs_get_blob(nvs, key, NULL, &size) != ESP_OK || size <= len) {
+        return NULL;
+    }
+    char *blob = malloc(size);
+    if (blob == NULL) {
+        return NULL;
+    }
+    if (nvs_get_blob(nvs, key, blob, &size) != ESP_OK || memcmp(blob, string, len) != 0 || blob[size - 1] != '\0') {
+        free(blob);
+        return NULL;
+    }
+    memmove(blob, blob + len, size - len);
+    esp_mn_g2p_hits++;
+    return blob;
+}
+
+// Store string and its phonemes, nvs_commit() is left to the caller
+static esp_err_t esp_mn_g2p_cache_put(nvs_handle_t nvs, const char *string, const char *phonemes)
+{
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    esp_mn_g2p_key(string, key);
+    size_t len = strlen(string) + 1;
+    size_t phonemes_len = strlen(phonemes) + 1;
+    char *blob = malloc(len + phonemes_len);
+    if (blob == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(blob, string, len);
+    memcpy(blob + len, phonemes, phonemes_len);
+
+    uint32_t count = 0;
+    nvs_get_u32(nvs, ESP_MN_G2P_COUNT_KEY, &count);
+    esp_err_t err = ESP_OK;
+    if (count >= CONFIG_SR_MN_G2P_CACHE_MAX_ENTRIES) {
+        err = esp_mn_g2p_cache_evict(nvs);
+        if (err == ESP_OK) {
+            count--;
+        } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+            // nothing to evict, the count was stale
+            count = 0;
+            err = ESP_OK;
+        }
+    }
+    uint32_t seq = 0;
+    nvs_get_u32(nvs, ESP_MN_G2P_NEXT_SEQ_KEY, &seq);
+    char seq_key[NVS_KEY_NAME_MAX_SIZE];
+    esp_mn_g2p_seq_key(key, seq_key);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(nvs, key, blob, len + phonemes_len);
+    }
+    if (err == ESP_OK) {
+        err = nvs_set_u32(nvs, seq_key, seq);
+    }
+    if (err == ESP_OK) {
+        err = nvs_set_u32(nvs, ESP_MN_G2P_NEXT_SEQ_KEY, seq + 1);
+    }
+    if (err == ESP_OK) {
+        err = nvs_set_u32(nvs, ESP_MN_G2P_COUNT_KEY, count + 1);
+    }
+    free(blob);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "G2P cache: %s not stored (%s)", string, esp_err_to_name(err));
+    }
+    return err;
+}
+#endif
+
+#ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
+// flite_g2p() through the G2P cache
+static char *esp_mn_g2p(const char *string)
+{
+#if CONFIG_SR_MN_G2P_CACHE
+    nvs_handle_t nvs;
+    if (esp_mn_g2p_cache_open(&nvs) == ESP_OK) {
+        char *phonemes = esp_mn_g2p_cache_get(nvs, string);
+        if (phonemes == NULL) {
+            esp_mn_g2p_misses++;
+            phonemes = flite_g2p(string, 1);
+            if (phonemes && esp_mn_g2p_cache_put(nvs, string, phonemes) == ESP_OK) {
+                nvs_commit(nvs);
+            }
+        }
+        nvs_close(nvs);
+        return phonemes;
+    }
+#endif
+    esp_mn_g2p_misses++;
+    return flite_g2p(string, 1);
+}
+#endif
+
+static void esp_mn_index_reset(void)
+{
+    free(esp_mn_nodes);
+    free(esp_mn_slots);
+    esp_mn_nodes = NULL;
+    esp_mn_slots = NULL;
+    esp_mn_nodes_num = 0;
+    esp_mn_nodes_cap = 0;
+    esp_mn_slots_mask = 0;
+    esp_mn_slots_used = 0;
+    esp_mn_tail = esp_mn_root;
+}
+
+// Slot holding string, or -1
+static int esp_mn_slot_find(const char *string)
+{
+    if (esp_mn_slots == NULL) {
+        return -1;
+    }
+    uint32_t slot = esp_mn_hash(string) & esp_mn_slots_mask;
+    while (esp_mn_slots[slot] != NULL) {
+        if (esp_mn_slots[slot] != ESP_MN_SLOT_DELETED && strcmp(esp_mn_slots[slot]->phrase->string, string) == 0) {
+            return slot;
+        }
+        slot = (slot + 1) & esp_mn_slots_mask;
+    }
+    return -1;
+}
+
+static void esp_mn_slot_put(esp_mn_node_t *node)
+{
+    uint32_t slot = esp_mn_hash(node->phrase->string) & esp_mn_slots_mask;
+    while (esp_mn_slots[slot] != NULL && esp_mn_slots[slot] != ESP_MN_SLOT_DELETED) {
+        slot = (slot + 1) & esp_mn_slots_mask;
+    }
+    if (esp_mn_slots[slot] == NULL) {
+        esp_mn_slots_used++;
+    }
+    esp_mn_slots[slot] = node;
+}
+
+// Rebuild the hash with room for at least n commands, which also drops tombstones
+static esp_err_t esp_mn_slots_rebuild(int n)
+{
+    uint32_t size = 16;
+    while (size < (uint32_t)n * 2) {
+        size <<= 1;
+    }
+    esp_mn_node_t **slots = _esp_mn_calloc_(size, sizeof(esp_mn_node_t *));
+    ESP_RETURN_ON_FALSE(NULL != slots, ESP_ERR_NO_MEM, TAG, "Fail to alloc command index");
+    free(esp_mn_slots);
+    esp_mn_slots = slots;
+    esp_mn_slots_mask = size - 1;
+    esp_mn_slots_used = 0;
+    for (int i = 0; i < esp_mn_nodes_num; i++) {
+        esp_mn_slot_put(esp_mn_nodes[i]);
+    }
+    return ESP_OK;
+}
+
+// Append node to the list and both indexes
+static esp_err_t esp_mn_node_append(esp_mn_node_t *node)
+{
+    if (esp_mn_nodes_num == esp_mn_nodes_cap) {
+        int cap = esp_mn_nodes_cap ? esp_mn_nodes_cap * 2 : 32;
+        esp_mn_node_t **nodes = _esp_mn_calloc_(cap, sizeof(esp_mn_node_t *));
+        ESP_RETURN_ON_FALSE(NULL != nodes, ESP_ERR_NO_MEM, TAG, "Fail to alloc command index");
+        if (esp_mn_nodes_num) {
+            memcpy(nodes, esp_mn_nodes, esp_mn_nodes_num * sizeof(esp_mn_node_t *));
+        }
+        free(esp_mn_nodes);
+        esp_mn_nodes = nodes;
+        esp_mn_nodes_cap = cap;
+    }
+    if ((esp_mn_slots_used + 1) * 2 > esp_mn_slots_mask + 1 || esp_mn_slots == NULL) {
+        ESP_RETURN_ON_FALSE(ESP_OK == esp_mn_slots_rebuild(esp_mn_nodes_num + 1), ESP_ERR_NO_MEM, TAG,
+                            "Fail to grow command index");
+    }
+
+    esp_mn_nodes[esp_mn_nodes_num++] = node;
+    esp_mn_slot_put(node);
+    esp_mn_tail->next = node;
+    esp_mn_tail = node;
+    return ESP_OK;
+}
+
 esp_err_t esp_mn_commands_alloc(const esp_mn_iface_t *multinet, model_iface_data_t *model_data)
 {
     if (esp_mn_root != NULL) {
         esp_mn_commands_free();
     }
     esp_mn_root = esp_mn_node_alloc(NULL);
+    esp_mn_index_reset();
     esp_mn_model_handle = multinet;
     esp_mn_model_data = model_data;
     return ESP_OK;
@@ -44,9 +461,11 @@ esp_err_t esp_mn_commands_alloc(const esp_mn_iface_t *multinet, model_iface_data
 
 esp_err_t esp_mn_commands_free(void)
 {
+    esp_mn_commands_batch_abort();
     esp_mn_commands_clear();
     esp_mn_node_free(esp_mn_root);
     esp_mn_root = NULL;
+    esp_mn_index_reset();
     esp_mn_model_handle = NULL;
     esp_mn_model_data = NULL;
 
@@ -55,44 +474,125 @@ esp_err_t esp_mn_commands_free(void)
 
 int esp_mn_commands_num(void)
 {
-    esp_mn_node_t *t = esp_mn_root;
-    int i = 0;
-    while (t->next) {
-        t = t->next;
-        i++;
+    return esp_mn_nodes_num;
+}
+
+void esp_mn_commands_mem_info(size_t *used, size_t *reserved, size_t *reclaimable)
+{
+    if (used) {
+        *used = esp_mn_arena.used;
+    }
+    if (reserved) {
+        *reserved = esp_mn_arena.size;
+    }
+    if (reclaimable) {
+        *reclaimable = esp_mn_arena.dead;
     }
-    return i;
+}
+
+// Copy the live commands to a new arena in list order and give the old blocks back.
+// Phrase pointers change, the waves stay where they are.
+static esp_err_t esp_mn_arena_compact(void)
+{
+    esp_mn_node_t **nodes = NULL;
+    if (esp_mn_nodes_num) {
+        nodes = _esp_mn_calloc_(esp_mn_nodes_num, sizeof(esp_mn_node_t *));
+        ESP_RETURN_ON_FALSE(NULL != nodes, ESP_ERR_NO_MEM, TAG, "Fail to alloc command index");
+    }
+    esp_mn_arena_t old = esp_mn_arena;
+    memset(&esp_mn_arena, 0, sizeof(esp_mn_arena));
+    for (int i = 0; i < esp_mn_nodes_num; i++) {
+        esp_mn_phrase_t *from = esp_mn_nodes[i]->phrase;
+        esp_mn_phrase_t *phrase = esp_mn_arena_phrase(from->command_id, from->string, from->phonemes);
+        nodes[i] = phrase ? esp_mn_arena_alloc(&esp_mn_arena, sizeof(esp_mn_node_t)) : NULL;
+        if (nodes[i] == NULL) {
+            // keep the list as it is
+            esp_mn_arena_reset(&esp_mn_arena);
+            esp_mn_arena = old;
+            free(nodes);
+            return ESP_ERR_NO_MEM;
+        }
+        phrase->threshold = from->threshold;
+        phrase->wave = from->wave;
+        nodes[i]->phrase = phrase;
+        nodes[i]->next = NULL;
+    }
+
+    esp_mn_node_t *prev = esp_mn_root;
+    for (int i = 0; i < esp_mn_nodes_num; i++) {
+        esp_mn_nodes[i] = nodes[i];
+        prev->next = nodes[i];
+        prev = nodes[i];
+    }
+    prev->next = NULL;
+    esp_mn_tail = prev;
+    free(nodes);
+
+    // same number of commands, so the hash is refilled in place, which also drops tombstones
+    if (esp_mn_slots) {
+        memset(esp_mn_slots, 0, (esp_mn_slots_mask + 1) * sizeof(esp_mn_node_t *));
+        esp_mn_slots_used = 0;
+        for (int i = 0; i < esp_mn_nodes_num; i++) {
+            esp_mn_slot_put(esp_mn_nodes[i]);
+        }
+    }
+    esp_mn_arena_reset(&old);
+    return ESP_OK;
 }
 
 esp_err_t esp_mn_commands_clear(void)
 {
     ESP_RETURN_ON_FALSE(NULL != esp_mn_root, ESP_ERR_INVALID_STATE, TAG, "The mn commands is not initialized");
 
-    esp_mn_node_t *t = esp_mn_root->next;
-    while (t) {
-        esp_mn_node_t *cur_node = t;
-        t = t->next;
-        esp_mn_node_free(cur_node);
+    for (esp_mn_node_t *t = esp_mn_root->next; t; t = t->next) {
+        free(t->phrase->wave);
     }
     esp_mn_root->next = NULL;
+    esp_mn_index_reset();
+    esp_mn_arena_reset(&esp_mn_arena);
 
     return ESP_OK;
 }
 
 esp_mn_node_t *esp_mn_command_search(const char *string)
 {
-    esp_mn_node_t *temp = esp_mn_root;
     if(NULL == esp_mn_root) {
         return NULL;
     }
 
-    while (temp->next) {
-        temp = temp->next;
-        if (strcmp(string, temp->phrase->string) == 0) {
-            return temp;
+    int slot = esp_mn_slot_find(string);
+    return slot < 0 ? NULL : esp_mn_slots[slot];
+}
+
+// Add a checked command, or change the id of an existing one
+static esp_err_t esp_mn_command_insert(int command_id, const char *string, const char *phonemes)
+{
+    esp_mn_node_t *temp = esp_mn_command_search(string);
+
+    if (temp != NULL) {
+        // command already exists
+        if (command_id != temp->phrase->command_id) {
+            // change command id
+            temp->phrase->command_id = command_id;
+        } else {
+            // it's exactly the same, do nothing
+            ESP_LOGI(TAG, "command %d: (%s) already exists.", command_id, string);
         }
+        return ESP_OK;
     }
-    return NULL;
+
+    esp_mn_phrase_t *phrase = esp_mn_arena_phrase(command_id, string, phonemes);
+    if (phrase == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_mn_node_t *new_node = esp_mn_arena_alloc(&esp_mn_arena, sizeof(esp_mn_node_t));
+    if (new_node == NULL) {
+        esp_mn_arena.dead += esp_mn_arena_phrase_size(phrase);
+        return ESP_ERR_NO_MEM;
+    }
+    new_node->phrase = phrase;
+    new_node->next = NULL;
+    return esp_mn_node_append(new_node);
 }
 
 esp_err_t esp_mn_commands_add(int command_id, const char *string)
@@ -101,15 +601,15 @@ esp_err_t esp_mn_commands_add(int command_id, const char *string)
         ESP_LOGE(TAG, "Please create mn model first.\n");
         return ESP_ERR_INVALID_STATE;
     }
-    esp_mn_node_t *temp = esp_mn_root;
     int last_node_elem_num = esp_mn_commands_num();
     ESP_RETURN_ON_FALSE(ESP_MN_MAX_PHRASE_NUM >= last_node_elem_num, ESP_ERR_INVALID_STATE, TAG, "The number of speech commands exceed ESP_MN_MAX_PHRASE_NUM");
 
 #ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
-    char *phonemes = flite_g2p(string, 1);
+    char *phonemes = esp_mn_g2p(string);
     if (esp_mn_model_handle->check_speech_command(esp_mn_model_data, phonemes) == 0) {
         // error message is printed inside check_speech_command
         ESP_LOGE(TAG, "invalid command, please check format, %s (%s).\n", string, phonemes);
+        free(phonemes);
         return ESP_ERR_INVALID_STATE;
     }
 #else
@@ -124,40 +624,13 @@ esp_err_t esp_mn_commands_add(int command_id, const char *string)
 //     ESP_LOGW(TAG, "For English, please use esp_mn_commands_phoneme_add() to add graphemes and phonemes!");
 // #endif
 
-    temp = esp_mn_command_search(string);
-
-    if (temp != NULL) {
-        // command already exists
-        if (command_id != temp->phrase->command_id) {
-            // change command id
-            temp->phrase->command_id = command_id;
-        } else {
-            // it's exactly the same, do nothing
-            ESP_LOGI(TAG, "command %d: (%s) already exists.", command_id, string);
-        }
-        return ESP_OK;
-    }
-
-    temp = esp_mn_root;
-
-    esp_mn_phrase_t *phrase = esp_mn_phrase_alloc(command_id, string);
-    if (phrase == NULL) {
-        return ESP_ERR_INVALID_STATE;
-    }
 #ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
-    int phoneme_len = strlen(phonemes);
-    phrase->phonemes = _esp_mn_calloc_(phoneme_len+1, sizeof(char));
-    memcpy(phrase->phonemes, phonemes, phoneme_len);
-    phrase->phonemes[phoneme_len] = '\0';
+    esp_err_t ret = esp_mn_command_insert(command_id, string, phonemes);
     free(phonemes);
+    return ret;
+#else
+    return esp_mn_command_insert(command_id, string, NULL);
 #endif
-    esp_mn_node_t *new_node = esp_mn_node_alloc(phrase);
-    while (temp->next != NULL) {
-        temp = temp->next;
-    }
-    temp->next = new_node;
-
-    return ESP_OK;
 }
 
 esp_err_t esp_mn_commands_phoneme_add(int command_id, const char *string, const char *phonemes)
@@ -166,7 +639,6 @@ esp_err_t esp_mn_commands_phoneme_add(int command_id, const char *string, const
         ESP_LOGE(TAG, "Please create mn model first.\n");
         return ESP_ERR_INVALID_STATE;
     }
-    esp_mn_node_t *temp = esp_mn_root;
     int last_node_elem_num = esp_mn_commands_num();
     ESP_RETURN_ON_FALSE(ESP_MN_MAX_PHRASE_NUM >= last_node_elem_num, ESP_ERR_INVALID_STATE, TAG, "The number of speech commands exceed ESP_MN_MAX_PHRASE_NUM");
 
@@ -186,114 +658,90 @@ esp_err_t esp_mn_commands_phoneme_add(int command_id, const char *string, const
     }
 #endif
 
-    temp = esp_mn_command_search(string);
-
-    if (temp != NULL) {
-        // command already exists
-        if (command_id != temp->phrase->command_id) {
-            // change command id
-            temp->phrase->command_id = command_id;
-        } else {
-            // it's exactly the same, do nothing
-            ESP_LOGI(TAG, "command %d: (%s) already exists.", command_id, string);
-        }
-        return ESP_OK;
-    }
-
-    temp = esp_mn_root;
 #if CONFIG_SR_MN_EN_MULTINET5_SINGLE_RECOGNITION_QUANT8
     //TODO:: add string for mn5
-    esp_mn_phrase_t *phrase = esp_mn_phrase_alloc(command_id, phonemes);
+    return esp_mn_command_insert(command_id, phonemes, phonemes);
 #else
-    esp_mn_phrase_t *phrase = esp_mn_phrase_alloc(command_id, string);
+    return esp_mn_command_insert(command_id, string, phonemes);
 #endif
-    if (phrase == NULL) {
-        return ESP_ERR_INVALID_STATE;
-    }
-    if (phonemes) {
-        int phoneme_len = strlen(phonemes);
-        phrase->phonemes = _esp_mn_calloc_(phoneme_len+1, sizeof(char));
-        memcpy(phrase->phonemes, phonemes, phoneme_len);
-        phrase->phonemes[phoneme_len] = '\0';
-    }
-
-    esp_mn_node_t *new_node = esp_mn_node_alloc(phrase);
-    while (temp->next != NULL) {
-        temp = temp->next;
-    }
-    temp->next = new_node;
-
-    return ESP_OK;
 }
 
 esp_err_t esp_mn_commands_modify(const char *old_string, const char *new_string)
 {
 #ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
-    char *phonemes = flite_g2p(new_string, 1);
+    char *phonemes = esp_mn_g2p(new_string);
     if (esp_mn_model_handle->check_speech_command(esp_mn_model_data, phonemes) == 0) {
         ESP_LOGE(TAG, "invalid command, please check format, %s (%s).\n", new_string, phonemes);
+        free(phonemes);
         return ESP_ERR_INVALID_STATE;
     }
 #else
+    char *phonemes = NULL;
     if (esp_mn_model_handle->check_speech_command(esp_mn_model_data, new_string) == 0) {
         ESP_LOGE(TAG, "invalid command, please check format, %s.\n", new_string);
         return ESP_ERR_INVALID_STATE;
     }
 #endif
     esp_mn_node_t *temp = esp_mn_root;
-    ESP_RETURN_ON_FALSE(NULL != esp_mn_root, ESP_ERR_INVALID_STATE, TAG, "The mn commands is not initialized");
+    if (NULL == esp_mn_root) {
+        ESP_LOGE(TAG, "The mn commands is not initialized");
+        free(phonemes);
+        return ESP_ERR_INVALID_STATE;
+    }
 
     // search old string to get command id
     temp = esp_mn_command_search(old_string);
 
-    // replace old phrase with new phrase
+    // replace old phrase with new phrase, the old one stays in the arena until the next update
+    esp_err_t ret = ESP_OK;
     if (temp != NULL) {
-        esp_mn_phrase_t *phrase = esp_mn_phrase_alloc(temp->phrase->command_id, new_string);
+        esp_mn_phrase_t *phrase = esp_mn_arena_phrase(temp->phrase->command_id, new_string, phonemes);
         if (phrase == NULL) {
-            return ESP_ERR_INVALID_STATE;
+            ret = ESP_ERR_NO_MEM;
+        } else {
+            // the node is rehashed under its new string
+            esp_mn_slots[esp_mn_slot_find(old_string)] = ESP_MN_SLOT_DELETED;
+            free(temp->phrase->wave);
+            esp_mn_arena.dead += esp_mn_arena_phrase_size(temp->phrase);
+            temp->phrase = phrase;
+            esp_mn_slot_put(temp);
         }
-#ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
-        int phoneme_len = strlen(phonemes);
-        phrase->phonemes = _esp_mn_calloc_(phoneme_len+1, sizeof(char));
-        memcpy(phrase->phonemes, phonemes, phoneme_len);
-        phrase->phonemes[phoneme_len] = '\0';
-        free(phonemes);
-#endif
-        esp_mn_phrase_free(temp->phrase);
-        temp->phrase = phrase;
     } else {
         ESP_LOGE(TAG, "No such speech command: \"%s\"", old_string);
-        return ESP_ERR_INVALID_STATE;
+        ret = ESP_ERR_INVALID_STATE;
     }
 
-    return ESP_OK;
+    free(phonemes);
+    return ret;
 }
 
 esp_err_t esp_mn_commands_remove(const char *string)
 {
-    esp_mn_node_t *temp = esp_mn_root;
     ESP_RETURN_ON_FALSE(NULL != esp_mn_root, ESP_ERR_INVALID_STATE, TAG, "The mn commands is not initialized");
 
-    // search string to get node point
-    bool flag = false;
-    while (temp->next) {
-        if (strcmp(string, temp->next->phrase->string) == 0) {
-            flag = true;
-            break;
-        }
-        temp = temp->next;
-    }
-
-    if (flag) {
-        esp_mn_node_t *rm_node = temp->next;
-        temp->next = temp->next->next;
-        esp_mn_node_free(rm_node);
-        return ESP_OK;
-    } else {
+    int slot = esp_mn_slot_find(string);
+    if (slot < 0) {
         ESP_LOGE(TAG, "No such speech command: \"%s\"", string);
         return ESP_ERR_INVALID_STATE;
     }
+    esp_mn_node_t *rm_node = esp_mn_slots[slot];
 
+    int pos = 0;
+    while (esp_mn_nodes[pos] != rm_node) {
+        pos++;
+    }
+    esp_mn_node_t *prev = pos > 0 ? esp_mn_nodes[pos - 1] : esp_mn_root;
+    prev->next = rm_node->next;
+    if (esp_mn_tail == rm_node) {
+        esp_mn_tail = prev;
+    }
+    memmove(esp_mn_nodes + pos, esp_mn_nodes + pos + 1, (esp_mn_nodes_num - pos - 1) * sizeof(esp_mn_node_t *));
+    esp_mn_nodes_num--;
+    esp_mn_slots[slot] = ESP_MN_SLOT_DELETED;
+    // the node stays in the arena until the next update
+    free(rm_node->phrase->wave);
+    rm_node->phrase->wave = NULL;
+    esp_mn_arena.dead += esp_mn_arena_phrase_size(rm_node->phrase) + ESP_MN_ARENA_ALIGN(sizeof(esp_mn_node_t));
     return ESP_OK;
 }
 
@@ -305,15 +753,11 @@ esp_mn_phrase_t *esp_mn_commands_get_from_index(int index)
     }
 
     // phrase index also is phrase id, which is the depth from this phrase node to root node
-    esp_mn_node_t *temp = esp_mn_root;
-    for (int i = -1; i < index; i++) {
-        if (temp->next == NULL) {
-            return NULL;
-        }
-        temp = temp->next;
+    if (index < 0 || index >= esp_mn_nodes_num) {
+        return NULL;
     }
 
-    return temp->phrase;
+    return esp_mn_nodes[index]->phrase;
 }
 
 esp_mn_phrase_t *esp_mn_commands_get_from_string(const char *string)
@@ -323,16 +767,8 @@ esp_mn_phrase_t *esp_mn_commands_get_from_string(const char *string)
         return NULL;
     }
 
-    // phrase index also is phrase id, which is the depth from this phrase node to root node
-    esp_mn_node_t *temp = esp_mn_root;
-    while (temp->next) {
-        if (strcmp(string, temp->next->phrase->string) == 0) {
-            return temp->next->phrase;
-        }
-        temp = temp->next;
-    }
-
-    return NULL;
+    esp_mn_node_t *node = esp_mn_command_search(string);
+    return node ? node->phrase : NULL;
 }
 
 char *esp_mn_commands_get_string(int command_id)
@@ -342,13 +778,11 @@ char *esp_mn_commands_get_string(int command_id)
         return NULL;
     }
 
-    // phrase index also is phrase id, which is the depth from this phrase node to root node
-    esp_mn_node_t *temp = esp_mn_root;
-    while (temp->next) {
-        if (temp->next->phrase->command_id == command_id) {
-            return temp->next->phrase->string;
+    // the first phrase with this id in list order
+    for (int i = 0; i < esp_mn_nodes_num; i++) {
+        if (esp_mn_nodes[i]->phrase->command_id == command_id) {
+            return esp_mn_nodes[i]->phrase->string;
         }
-        temp = temp->next;
     }
 
     return NULL;
@@ -357,6 +791,10 @@ char *esp_mn_commands_get_string(int command_id)
 esp_mn_error_t *esp_mn_commands_update()
 {
     ESP_RETURN_ON_FALSE(NULL != esp_mn_root, NULL, TAG, "The mn commands is not initialize");
+    // MultiNet is set up from the list again anyway, so this is when removed commands are freed
+    if (esp_mn_arena.dead && esp_mn_arena_compact() != ESP_OK) {
+        ESP_LOGW(TAG, "Fail to compact commands, %u bytes stay reserved", (unsigned)esp_mn_arena.dead);
+    }
     esp_mn_error_t *error = esp_mn_model_handle->set_speech_commands(esp_mn_model_data, esp_mn_root);
 
     if (error->num == 0) {
@@ -366,15 +804,262 @@ esp_mn_error_t *esp_mn_commands_update()
     return error;
 }
 
+esp_err_t esp_mn_commands_batch_begin(uint32_t flags)
+{
+    ESP_RETURN_ON_FALSE(NULL != esp_mn_root, ESP_ERR_INVALID_STATE, TAG, "The mn commands is not initialized");
+    ESP_RETURN_ON_FALSE(!esp_mn_batch_open, ESP_ERR_INVALID_STATE, TAG, "A command batch is already open");
+    esp_mn_batch_open = true;
+    esp_mn_batch_flags = flags;
+    esp_mn_batch_num = 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_mn_commands_batch_add(int command_id, const char *string, const char *phonemes)
+{
+    ESP_RETURN_ON_FALSE(NULL != string, ESP_ERR_INVALID_ARG, TAG, "input string is empty");
+    return esp_mn_commands_batch_add_len(command_id, string, strlen(string), phonemes);
+}
+
+esp_err_t esp_mn_commands_batch_add_len(int command_id, const char *string, size_t len, const char *phonemes)
+{
+    ESP_RETURN_ON_FALSE(esp_mn_batch_open, ESP_ERR_INVALID_STATE, TAG, "No command batch is open");
+    ESP_RETURN_ON_FALSE(NULL != string && len > 0, ESP_ERR_INVALID_ARG, TAG, "input string is empty");
+
+    if (esp_mn_batch_num == esp_mn_batch_cap) {
+        int cap = esp_mn_batch_cap ? esp_mn_batch_cap * 2 : 32;
+        esp_mn_staged_t *batch = _esp_mn_calloc_(cap, sizeof(esp_mn_staged_t));
+        ESP_RETURN_ON_FALSE(NULL != batch, ESP_ERR_NO_MEM, TAG, "Fail to alloc command batch");
+        if (esp_mn_batch_num) {
+            memcpy(batch, esp_mn_batch, esp_mn_batch_num * sizeof(esp_mn_staged_t));
+        }
+        free(esp_mn_batch);
+        esp_mn_batch = batch;
+        esp_mn_batch_cap = cap;
+    }
+
+    esp_mn_staged_t *staged = &esp_mn_batch[esp_mn_batch_num];
+    staged->command_id = command_id;
+    staged->string = esp_mn_arena_alloc(&esp_mn_batch_arena, len + 1);
+    staged->phonemes = phonemes ? esp_mn_arena_strdup(&esp_mn_batch_arena, phonemes) : NULL;
+    staged->g2p = NULL;
+    staged->invalid = false;
+    staged->g2p_cached = false;
+    if (staged->string == NULL || (phonemes && staged->phonemes == NULL)) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(staged->string, string, len);
+    staged->string[len] = '\0';
+    esp_mn_batch_num++;
+    return ESP_OK;
+}
+
+void esp_mn_commands_batch_abort(void)
+{
+    for (int i = 0; i < esp_mn_batch_num; i++) {
+        free(esp_mn_batch[i].g2p);
+    }
+    esp_mn_arena_reset(&esp_mn_batch_arena);
+    free(esp_mn_batch);
+    esp_mn_batch = NULL;
+    esp_mn_batch_num = 0;
+    esp_mn_batch_cap = 0;
+    esp_mn_batch_open = false;
+}
+
+#ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
+// G2P of every step-th staged command without phonemes, starting at first
+static void esp_mn_batch_g2p(int first, int step)
+{
+    for (int i = first; i < esp_mn_batch_num; i += step) {
+        if (esp_mn_batch[i].phonemes == NULL) {
+            esp_mn_batch[i].g2p = flite_g2p(esp_mn_batch[i].string, 1);
+            esp_mn_batch[i].phonemes = esp_mn_batch[i].g2p;
+        }
+    }
+}
+
+#if CONFIG_SR_MN_BATCH_G2P_DUAL_CORE
+static void esp_mn_batch_g2p_task(void *arg)
+{
+    esp_mn_batch_g2p(1, 2);
+    xTaskNotifyGive((TaskHandle_t)arg);
+    vTaskDelete(NULL);
+}
+#endif
+
+static void esp_mn_batch_g2p_run(void)
+{
+#if CONFIG_SR_MN_BATCH_G2P_DUAL_CORE
+    // odd entries on the other core, even entries here
+    if (esp_mn_batch_num > 1 &&
+        xTaskCreatePinnedToCore(esp_mn_batch_g2p_task, "mn_g2p", ESP_MN_G2P_TASK_STACK, xTaskGetCurrentTaskHandle(),
+                                uxTaskPriorityGet(NULL), NULL, !xPortGetCoreID()) == pdPASS) {
+        esp_mn_batch_g2p(0, 2);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        return;
+    }
+#endif
+    esp_mn_batch_g2p(0, 1);
+}
+
+// The G2P cache is only used from this task, the G2P itself may run on both cores
+static void esp_mn_batch_g2p_all(void)
+{
+#if CONFIG_SR_MN_G2P_CACHE
+    nvs_handle_t nvs;
+    bool cache = esp_mn_g2p_cache_open(&nvs) == ESP_OK;
+    for (int i = 0; cache && i < esp_mn_batch_num; i++) {
+        esp_mn_staged_t *staged = &esp_mn_batch[i];
+        if (staged->phonemes == NULL) {
+            staged->g2p = esp_mn_g2p_cache_get(nvs, staged->string);
+            staged->phonemes = staged->g2p;
+            staged->g2p_cached = staged->g2p != NULL;
+        }
+    }
+#endif
+
+    uint32_t misses = 0;
+    for (int i = 0; i < esp_mn_batch_num; i++) {
+        misses += esp_mn_batch[i].phonemes == NULL;
+    }
+    esp_mn_g2p_misses += misses;
+    if (misses) {
+        esp_mn_batch_g2p_run();
+    }
+
+#if CONFIG_SR_MN_G2P_CACHE
+    if (cache) {
+        bool stored = false;
+        for (int i = 0; i < esp_mn_batch_num; i++) {
+            esp_mn_staged_t *staged = &esp_mn_batch[i];
+            if (staged->g2p && !staged->g2p_cached) {
+                stored |= esp_mn_g2p_cache_put(nvs, staged->string, staged->g2p) == ESP_OK;
+            }
+        }
+        if (stored) {
+            nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+#endif
+}
+#endif
+
+esp_err_t esp_mn_commands_batch_commit(esp_mn_error_t **error)
+{
+    if (error) {
+        *error = NULL;
+    }
+    ESP_RETURN_ON_FALSE(esp_mn_batch_open, ESP_ERR_INVALID_STATE, TAG, "No command batch is open");
+    if (NULL == esp_mn_root || esp_mn_model_handle == NULL || esp_mn_model_data == NULL) {
+        ESP_LOGE(TAG, "Please create mn model first.\n");
+        esp_mn_commands_batch_abort();
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // duplicates are counted too, so this may refuse a batch that would just fit
+    bool replace = esp_mn_batch_flags & ESP_MN_BATCH_REPLACE;
+    int total = esp_mn_batch_num + (replace ? 0 : esp_mn_commands_num());
+    if (total > ESP_MN_MAX_PHRASE_NUM) {
+        ESP_LOGE(TAG, "The number of speech commands exceed ESP_MN_MAX_PHRASE_NUM");
+        esp_mn_commands_batch_abort();
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+#ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
+    esp_mn_batch_g2p_all();
+#endif
+
+    // check everything before touching the list, an invalid command rejects the whole batch
+    // unless the caller asked to skip it
+    int invalid = 0;
+    for (int i = 0; i < esp_mn_batch_num; i++) {
+        esp_mn_staged_t *staged = &esp_mn_batch[i];
+#if CONFIG_SR_MN_EN_MULTINET7_QUANT || CONFIG_SR_MN_EN_MULTINET5_SINGLE_RECOGNITION_QUANT8
+        char *unit = staged->phonemes ? staged->phonemes : staged->string;
+#else
+        char *unit = staged->string;
+#endif
+#ifdef CONFIG_SR_MN_EN_MULTINET7_QUANT
+        if (staged->phonemes == NULL) {
+            ESP_LOGE(TAG, "G2P failed, %s.\n", staged->string);
+            staged->invalid = true;
+            invalid++;
+            continue;
+        }
+#endif
+        if (esp_mn_model_handle->check_speech_command(esp_mn_model_data, unit) == 0) {
+            ESP_LOGE(TAG, "invalid command, please check format, %s (%s).\n", staged->string, unit);
+            staged->invalid = true;
+            invalid++;
+        }
+    }
+    if (invalid && !(esp_mn_batch_flags & ESP_MN_BATCH_SKIP_INVALID)) {
+        ESP_LOGE(TAG, "%d of %d commands are invalid, batch dropped", invalid, esp_mn_batch_num);
+        esp_mn_commands_batch_abort();
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (replace) {
+        esp_mn_commands_clear();
+    }
+    esp_err_t ret = ESP_OK;
+    for (int i = 0; i < esp_mn_batch_num && ret == ESP_OK; i++) {
+        esp_mn_staged_t *staged = &esp_mn_batch[i];
+        if (staged->invalid) {
+            continue;
+        }
+#if CONFIG_SR_MN_EN_MULTINET5_SINGLE_RECOGNITION_QUANT8
+        const char *string = staged->phonemes ? staged->phonemes : staged->string;
+#else
+        const char *string = staged->string;
+#endif
+        ret = esp_mn_command_insert(staged->command_id, string, staged->phonemes);
+    }
+    esp_mn_commands_batch_abort();
+    ESP_RETURN_ON_FALSE(ESP_OK == ret, ret, TAG, "Fail to add batch commands, list is partially updated");
+
+    esp_mn_error_t *update_error = esp_mn_commands_update();
+    if (error) {
+        *error = update_error;
+    }
+    return update_error ? ESP_FAIL : ESP_OK;
+}
+
+void esp_mn_g2p_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+    if (hits) {
+        *hits = esp_mn_g2p_hits;
+    }
+    if (misses) {
+        *misses = esp_mn_g2p_misses;
+    }
+}
+
+esp_err_t esp_mn_g2p_cache_clear(void)
+{
+#if CONFIG_SR_MN_G2P_CACHE
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(ESP_MN_G2P_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = esp_mn_g2p_cache_reset(nvs);
+    nvs_close(nvs);
+    esp_mn_g2p_hits = 0;
+    esp_mn_g2p_misses = 0;
+    return err;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 void esp_mn_commands_print(void)
 {
     ESP_LOGI(TAG, "---------------------SPEECH COMMANDS---------------------");
-    esp_mn_node_t *temp = esp_mn_root;
-    int phrase_id = 0;
-    while (temp->next) {
-        temp = temp->next;
-        ESP_LOGI(TAG, "Command ID%d, phrase ID%d: %s", temp->phrase->command_id, phrase_id, temp->phrase->string);
-        phrase_id++;
+    for (int phrase_id = 0; phrase_id < esp_mn_nodes_num; phrase_id++) {
+        esp_mn_phrase_t *phrase = esp_mn_nodes[phrase_id]->phrase;
+        ESP_LOGI(TAG, "Command ID%d, phrase ID%d: %s", phrase->command_id, phrase_id, phrase->string);
     }
     ESP_LOGI(TAG, "---------------------------------------------------------\n");
 }
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "esp_mn_iface.h"
 
@@ -105,6 +107,27 @@ esp_err_t esp_mn_commands_remove(const char *string);
  */
 esp_err_t esp_mn_commands_clear(void);
 
+/**
+ * @brief Get the number of speech commands in linked list
+ *
+ * @return the number of phrases, 0 if the list is not initialized
+ */
+int esp_mn_commands_num(void);
+
+/**
+ * @brief Get the memory held by the speech commands in linked list
+ *
+ * @note Phrases, strings, phonemes and nodes are carved from PSRAM blocks. The memory of
+ *       commands removed or modified is not reused at once: used still counts it, and it is
+ *       reported as reclaimable until esp_mn_commands_update() copies the live commands to
+ *       new blocks, or esp_mn_commands_clear() drops them all.
+ *
+ * @param used           Bytes handed out to the commands, may be NULL
+ * @param reserved       Bytes allocated from the heap for them, may be NULL
+ * @param reclaimable    Part of used held by removed or modified commands, may be NULL
+ */
+void esp_mn_commands_mem_info(size_t *used, size_t *reserved, size_t *reclaimable);
+
 /**
  * @brief Get string of command from command_id
  * 
@@ -145,6 +168,10 @@ esp_mn_phrase_t *esp_mn_commands_get_from_string(const char *string);
  * 
  * @Warning: Must be used after [add/remove/modify/clear] function, 
  *           otherwise the language model of multinet can not be updated.
+ *
+ * @note After commands were removed or modified, the live commands are first copied to new
+ *       memory, so phrases got from esp_mn_commands_get_from_index() or
+ *       esp_mn_commands_get_from_string() before the update must not be used after it.
  * 
  * @return
  *     - NULL                 Success
@@ -152,6 +179,97 @@ esp_mn_phrase_t *esp_mn_commands_get_from_string(const char *string);
  */
 esp_mn_error_t *esp_mn_commands_update();
 
+#define ESP_MN_BATCH_REPLACE        (1 << 0)    // clear the current commands at commit
+#define ESP_MN_BATCH_SKIP_INVALID   (1 << 1)    // leave invalid commands out instead of dropping the batch
+
+/**
+ * @brief Start staging a batch of speech commands.
+ *
+ * @note Commands added with esp_mn_commands_batch_add() are only checked, converted
+ *       by G2P and added to the list by esp_mn_commands_batch_commit(), which updates
+ *       MultiNet once for the whole batch.
+ *
+ * @param flags    ESP_MN_BATCH_* flags, 0 to add to the current commands all or nothing
+ *
+ * @return
+ *     - ESP_OK                  Success
+ *     - ESP_ERR_INVALID_STATE   The list is not initialized or a batch is already open
+ */
+esp_err_t esp_mn_commands_batch_begin(uint32_t flags);
+
+/**
+ * @brief Stage one speech command in the open batch.
+ *
+ * @param command_id    The command ID
+ * @param string        The command string of the speech commands
+ * @param phonemes      The phonemes of the speech commands, or NULL to run G2P at commit
+ *
+ * @return
+ *     - ESP_OK                  Success
+ *     - ESP_ERR_NO_MEM          No memory
+ *     - ESP_ERR_INVALID_ARG     Empty string
+ *     - ESP_ERR_INVALID_STATE   No batch is open
+ */
+esp_err_t esp_mn_commands_batch_add(int command_id, const char *string, const char *phonemes);
+
+/**
+ * @brief Same as esp_mn_commands_batch_add(), for a string that is not NUL terminated.
+ *
+ * @param command_id    The command ID
+ * @param string        The command string of the speech commands
+ * @param len           Length of string in bytes
+ * @param phonemes      The phonemes of the speech commands, or NULL to run G2P at commit
+ *
+ * @return see esp_mn_commands_batch_add()
+ */
+esp_err_t esp_mn_commands_batch_add_len(int command_id, const char *string, size_t len, const char *phonemes);
+
+/**
+ * @brief Check every staged command, add them to the list and update MultiNet once.
+ *
+ * @warning If any command is invalid the whole batch is dropped and the list is unchanged,
+ *          unless the batch was started with ESP_MN_BATCH_SKIP_INVALID.
+ *          With CONFIG_SR_MN_BATCH_G2P_DUAL_CORE, G2P of the batch is split across both cores.
+ *
+ * @param error    Optional, set to the phrases MultiNet could not parse, as esp_mn_commands_update()
+ *
+ * @return
+ *     - ESP_OK                  Success
+ *     - ESP_ERR_INVALID_ARG     At least one command is invalid
+ *     - ESP_ERR_INVALID_SIZE    The batch would exceed ESP_MN_MAX_PHRASE_NUM
+ *     - ESP_ERR_NO_MEM          No memory, the list may be partially updated
+ *     - ESP_ERR_INVALID_STATE   No batch is open or the list is not initialized
+ *     - ESP_FAIL                MultiNet rejected some phrases, see error
+ */
+esp_err_t esp_mn_commands_batch_commit(esp_mn_error_t **error);
+
+/**
+ * @brief Drop the open batch without touching the list.
+ */
+void esp_mn_commands_batch_abort(void);
+
+/**
+ * @brief Get the G2P counters since boot or the last esp_mn_g2p_cache_clear().
+ *
+ * @note Only MultiNet7 English converts command strings with G2P. A hit is a string whose
+ *       phonemes were read from the NVS cache (CONFIG_SR_MN_G2P_CACHE), a miss one that was
+ *       converted by G2P.
+ *
+ * @param hits      Strings served from the cache, may be NULL
+ * @param misses    Strings converted by G2P, may be NULL
+ */
+void esp_mn_g2p_cache_stats(uint32_t *hits, uint32_t *misses);
+
+/**
+ * @brief Erase the G2P cache from NVS and reset its counters.
+ *
+ * @return
+ *     - ESP_OK                  Success
+ *     - ESP_ERR_NOT_SUPPORTED   CONFIG_SR_MN_G2P_CACHE is disabled
+ *     - others                  NVS error
+ */
+esp_err_t esp_mn_g2p_cache_clear(void);
+
 /**
  * @brief Initialze the esp_mn_phrase_t struct by command id and command string .
  *
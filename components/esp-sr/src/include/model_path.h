@@ -74,6 +74,30 @@ char *esp_srmodel_filter(srmodel_list_t *models, const char *keyword1, const cha
  */
 int esp_srmodel_exists(srmodel_list_t *models, char *model_name);
 
+/**
+ * @brief Make the file data of one model accessible before creating it (e.g. wakenet->create).
+ *        With CONFIG_MODEL_LAZY_MMAP the model's files are mapped on the first acquire,
+ *        otherwise the whole partition is already mapped and only a reference is counted.
+ *        esp_srmodel_filter() and esp_srmodel_exists() already map the model they return and keep
+ *        it mapped until deinit, so callers that never acquire still get valid data. The first
+ *        acquire after that takes this reference over, and its release unmaps the model.
+ *        Acquire and release may be called from several tasks.
+ *
+ * @param models      The srmodel_list_t point allocated by esp_srmodel_init function.
+ * @param model_name  The specified model name
+ * @return 0 on success, -1 if the model does not exist or could not be mapped
+ */
+int esp_srmodel_acquire(srmodel_list_t *models, const char *model_name);
+
+/**
+ * @brief Drop a reference taken by esp_srmodel_acquire. The model's files are unmapped when the
+ *        last reference goes away, so destroy the model instance first.
+ *
+ * @param models      The srmodel_list_t point allocated by esp_srmodel_init function.
+ * @param model_name  The specified model name
+ */
+void esp_srmodel_release(srmodel_list_t *models, const char *model_name);
+
 /**
  * @brief Get wake words from model_name. 
  *        If there are multiple wake words in one model, all wake words will be joined by ";". 
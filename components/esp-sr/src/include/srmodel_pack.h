@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Reader for the model pack (srmodels.bin) written by model/pack_model.py. It only depends on the
+ * C library, so the loader in model_path.c and the host tool in tool/srmodel_pack share it.
+ *
+ * v2 pack: magic "SRMB", version, header_len, header_crc, then the v1 table, then one CRC32 per
+ *          file in table order. header_crc covers bytes [16, header_len).
+ * v1 pack: model_num, then per model name[32], file_num and per file name[32], start, len.
+ * File offsets are relative to the start of the pack in both versions.
+ */
+#define SRMODEL_PACK_MAGIC      0x424D5253  // "SRMB"
+#define SRMODEL_PACK_VERSION    2
+#define SRMODEL_PACK_PREFIX_LEN 16          // magic, version, header_len, header_crc
+#define SRMODEL_PACK_NAME_LEN   32
+#define SRMODEL_PACK_MODEL_LEN  (SRMODEL_PACK_NAME_LEN + 4)  // model record: name, file count
+#define SRMODEL_PACK_FILE_LEN   (SRMODEL_PACK_NAME_LEN + 8)  // file record: name, start, length
+
+typedef enum {
+    SRMODEL_PACK_OK = 0,
+    SRMODEL_PACK_ERR_TRUNCATED = -1,    // the header is shorter than its tables claim
+    SRMODEL_PACK_ERR_VERSION = -2,      // unsupported pack format version
+    SRMODEL_PACK_ERR_HEADER_CRC = -3,   // header checksum mismatch
+    SRMODEL_PACK_ERR_RANGE = -4,        // a file lies outside the pack
+} srmodel_pack_err_t;
+
+typedef struct {
+    const char *table;          // model_num followed by the model records
+    const char *crcs;           // per-file CRC32 table, NULL for v1 packs
+    uint32_t version;           // 1 or 2
+    uint32_t header_len;        // bytes from the start of the pack to the end of the header
+    uint32_t header_crc;        // v2 only
+    uint32_t model_num;
+    uint32_t file_num;          // files of all models
+} srmodel_pack_t;
+
+typedef struct {
+    const char *name;           // SRMODEL_PACK_NAME_LEN bytes, NUL padded, not terminated when full
+    uint32_t file_num;
+} srmodel_pack_model_t;
+
+typedef struct {
+    const char *name;           // same as srmodel_pack_model_t::name
+    uint32_t start;             // offset from the start of the pack
+    uint32_t len;
+} srmodel_pack_file_t;
+
+static inline uint32_t srmodel_pack_u32(const void *data)
+{
+    // unsigned, so bytes >= 0x80 are not sign-extended on targets where char is signed
+    const uint8_t *p = (const uint8_t *)data;
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void srmodel_pack_put_u32(void *data, uint32_t v)
+{
+    uint8_t *p = (uint8_t *)data;
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+    p[3] = (v >> 24) & 0xff;
+}
+
+/**
+ * @brief CRC32 as used by the pack (zlib / esp_rom_crc32_le), chainable through crc.
+ */
+uint32_t srmodel_pack_crc32(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief Bounds-check a pack header and fill pack.
+ *
+ * @param pack       Output description of the pack
+ * @param hdr        Start of the pack
+ * @param hdr_len    Number of readable bytes at hdr, at least the whole header
+ * @param data_size  Size of the whole pack (or the partition holding it) file ranges are checked against
+ *
+ * @return SRMODEL_PACK_OK or a srmodel_pack_err_t error
+ */
+int srmodel_pack_open(srmodel_pack_t *pack, const char *hdr, uint32_t hdr_len, uint32_t data_size);
+
+/**
+ * @brief Start of the model table of a header, skipping the v2 prefix if there is one.
+ *        Does not validate anything, use srmodel_pack_open() for untrusted data.
+ */
+const char *srmodel_pack_table(const char *hdr);
+
+/**
+ * @brief Decode the model record at p. Returns the first file record of the model.
+ */
+const char *srmodel_pack_model(const char *p, srmodel_pack_model_t *model);
+
+/**
+ * @brief Decode the file record at p. Returns the next file or model record.
+ */
+const char *srmodel_pack_file(const char *p, srmodel_pack_file_t *file);
+
+/**
+ * @brief Stored CRC32 of file index (in table order) of a v2 pack.
+ */
+uint32_t srmodel_pack_file_crc(const srmodel_pack_t *pack, uint32_t index);
+
+/**
+ * @brief Short description of a srmodel_pack_err_t.
+ */
+const char *srmodel_pack_strerror(int err);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,9 +1,13 @@
 #include "model_path.h"
+#include "srmodel_pack.h"
 #include "esp_wn_models.h"
 #include "stdio.h"
 #include "string.h"
+#include <stdint.h>
+#include <stdlib.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <unistd.h>
 // #ifndef CONFIG_IDF_TARGET_ESP32P4
 // #include "esp_mn_models.h"
 // #endif
@@ -17,6 +21,23 @@
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 #include "spi_flash_mmap.h"
 #endif
+#include "esp_rom_crc.h"
+#include <sys/lock.h>
+#if CONFIG_MODEL_VERIFY_NVS_CACHE || CONFIG_MODEL_SDCARD_STAGING
+#define SRMODEL_USE_NVS 1
+#include "nvs.h"
+#endif
+#else
+typedef int _lock_t;    // host builds are single threaded
+#define _lock_acquire(lock) ((void)(lock))
+#define _lock_release(lock) ((void)(lock))
+#endif
+
+
+#if defined(ESP_PLATFORM) && defined(CONFIG_MODEL_LAZY_MMAP) && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#define SRMODEL_LAZY_MMAP 1
+#else
+#define SRMODEL_LAZY_MMAP 0
 #endif
 
 static char *TAG = "MODEL_LOADER";
@@ -28,9 +49,10 @@ void set_model_base_path(const char *base_path)
     SRMODE_BASE_PATH = (char *)base_path;
 }
 
-char *get_model_info(char *data, int size)
+// Copy the first non-comment line onwards of a _MODEL_INFO_ file into out (size + 1 bytes).
+// Returns out, or NULL if the file only holds comments.
+static char *get_model_info_to(char *data, int size, char *out)
 {
-    char *model_info = NULL;
     // Prase
     // if the line starts with '#', the line is a comment
     // else the line is model information
@@ -43,20 +65,118 @@ char *get_model_info(char *data, int size)
             data++;
             size--;
             continue;
-        } else if (data != NULL && size > 0) {
-            model_info = (char *)malloc((size + 1) * sizeof(char));
-            memcpy(model_info, data, size);
-            if (model_info[size - 1] == '\n') {
-                model_info[size - 1] = '\0';
+        } else {
+            memcpy(out, data, size);
+            if (out[size - 1] == '\n') {
+                out[size - 1] = '\0';
             }
-            model_info[size] = '\0';
-            break;
+            out[size] = '\0';
+            return out;
         }
     }
 
+    return NULL;
+}
+
+char *get_model_info(char *data, int size)
+{
+    char *model_info = (char *)malloc((size + 1) * sizeof(char));
+    if (get_model_info_to(data, size, model_info) == NULL) {
+        free(model_info);
+        return NULL;
+    }
     return model_info;
 }
 
+// Open-addressing FNV-1a table mapping model names to their index in the loaded list.
+// Slots hold index + 1, 0 marks an empty slot.
+static srmodel_list_t *index_models = NULL;
+static uint16_t *index_slots = NULL;
+static uint32_t index_mask = 0;
+
+static uint32_t srmodel_name_hash(const char *name)
+{
+    uint32_t h = 2166136261u;
+    while (*name) {
+        h ^= (uint8_t)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void srmodel_index_free(void)
+{
+    free(index_slots);
+    index_slots = NULL;
+    index_models = NULL;
+    index_mask = 0;
+}
+
+static void srmodel_index_build(srmodel_list_t *models)
+{
+    srmodel_index_free();
+    if (models == NULL || models->num <= 0 || models->num >= UINT16_MAX) {
+        return;
+    }
+
+    uint32_t size = 4;
+    while (size < (uint32_t)models->num * 2) {
+        size <<= 1;
+    }
+    index_slots = (uint16_t *)calloc(size, sizeof(uint16_t));
+    if (index_slots == NULL) {
+        return; // lookups fall back to a linear scan
+    }
+    index_mask = size - 1;
+    for (int i = 0; i < models->num; i++) {
+        uint32_t slot = srmodel_name_hash(models->model_name[i]) & index_mask;
+        while (index_slots[slot] != 0) {
+            slot = (slot + 1) & index_mask;
+        }
+        index_slots[slot] = i + 1;
+    }
+    index_models = models;
+}
+
+// Index of model_name in models, or -1
+static int srmodel_index_find(srmodel_list_t *models, const char *model_name)
+{
+    if (models == index_models && index_slots != NULL) {
+        uint32_t slot = srmodel_name_hash(model_name) & index_mask;
+        while (index_slots[slot] != 0) {
+            int i = index_slots[slot] - 1;
+            if (strcmp(models->model_name[i], model_name) == 0) {
+                return i;
+            }
+            slot = (slot + 1) & index_mask;
+        }
+        return -1;
+    }
+
+    for (int i = 0; i < models->num; i++) {
+        if (strcmp(models->model_name[i], model_name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Per-model mapping state, only for lists parsed from a pack. Without lazy mapping every model
+// is permanently mapped and only the reference count is kept.
+typedef struct {
+    uint32_t *offsets;          // partition offset of each file
+    int refs;                   // esp_srmodel_acquire() count, plus one while pinned
+    bool pinned;                // handed out by name without an acquire, see srmodel_pin()
+    void *map_handle;           // esp_partition_mmap_handle_t * while mapped lazily
+} srmodel_map_t;
+
+static srmodel_map_t *model_maps = NULL;
+// Guards refs, pinned and the mapping, models are acquired and released from several tasks
+static _lock_t model_maps_lock;
+#if SRMODEL_LAZY_MMAP
+static char *lazy_header = NULL;    // heap copy of the pack header, model names point into it
+#endif
+
 char *get_wake_words_from_info(char *model_info)
 {
     if (model_info == NULL)
@@ -110,72 +230,232 @@ static srmodel_list_t *srmodel_list_alloc(void)
 }
 
 #ifdef ESP_PLATFORM
-srmodel_list_t *read_models_form_spiffs(esp_vfs_spiffs_conf_t *conf)
+// Model names found in the SPIFFS directory are cached in a manifest file next to the models:
+//   "SRMF <version> <total> <used> <hash>\n" followed by one model name per line.
+// SPIFFS has no directory index, every readdir() walks all object headers, so the manifest is
+// used instead as long as the filesystem size and used bytes match the values it was written for,
+// and so does the hash of the name, size and mtime of every listed model's _MODEL_INFO_ file.
+// The hash costs one stat() per model instead of a walk over every file of every model.
+#define SRMODEL_MANIFEST_NAME    ".manifest"
+#define SRMODEL_MANIFEST_VERSION 2
+#define SRMODEL_MANIFEST_MAX     4096
+#define SRMODEL_INFO_SUFFIX      "/_MODEL_INFO_"
+
+// Build models->model_name from num NUL-separated names. The pointer array and the names share
+// one allocation.
+static void spiffs_set_model_names(srmodel_list_t *models, const char *names, size_t len, int num)
 {
-    if (static_srmodels == NULL) {
-        static_srmodels = srmodel_list_alloc();
-    } else {
-        return static_srmodels;
+    char **table = (char **)malloc(num * sizeof(char *) + len);
+    if (table == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %d model names", num);
+        return;
     }
+    char *dst = (char *)(table + num);
+    memcpy(dst, names, len);
+    for (int i = 0; i < num; i++) {
+        table[i] = dst;
+        dst += strlen(dst) + 1;
+    }
+    models->model_name = table;
+    models->num = num;
+}
 
-    srmodel_list_t *models = static_srmodels;
-
-    struct dirent *ret;
-    DIR *dir = NULL;
-    dir = opendir(conf->base_path);
-    int model_num = 0;
-    int idx = 0;
+// Single readdir() pass collecting the names of all models (directories holding a _MODEL_INFO_)
+static char *spiffs_scan_models(const char *base_path, size_t *len, int *num)
+{
+    DIR *dir = opendir(base_path);
+    if (dir == NULL) {
+        return NULL;
+    }
 
-    if (dir != NULL) {
-        // get the number of models
-        while ((ret = readdir(dir)) != NULL) {
-            // NULL if reach the end of directory
+    size_t suffix_len = strlen(SRMODEL_INFO_SUFFIX);
+    size_t cap = 256;
+    char *names = (char *)malloc(cap);
+    *len = 0;
+    *num = 0;
 
-            if (ret->d_type == DT_DIR) { // continue if d_type is not file
-                continue;
+    struct dirent *ent;
+    while (names != NULL && (ent = readdir(dir)) != NULL) {
+        if (ent->d_type == DT_DIR) { // continue if d_type is not file
+            continue;
+        }
+        size_t name_len = strlen(ent->d_name);
+        if (name_len <= suffix_len || strcmp(ent->d_name + name_len - suffix_len, SRMODEL_INFO_SUFFIX) != 0) {
+            continue;
+        }
+        name_len -= suffix_len;
+        if (*len + name_len + 1 > cap) {
+            cap = (*len + name_len + 1) * 2;
+            char *grown = (char *)realloc(names, cap);
+            if (grown == NULL) {
+                free(names);
+                names = NULL;
+                break;
             }
+            names = grown;
+        }
+        memcpy(names + *len, ent->d_name, name_len);
+        names[*len + name_len] = '\0';
+        *len += name_len + 1;
+        (*num)++;
+    }
+    closedir(dir);
+    return names;
+}
 
-            int len = strlen(ret->d_name);
-            char *suffix = ret->d_name + len - 12;
+#if CONFIG_MODEL_SPIFFS_MANIFEST
+static uint32_t spiffs_manifest_hash_bytes(uint32_t h, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (len--) {
+        h ^= *p++;
+        h *= 16777619u;
+    }
+    return h;
+}
 
-            if (strcmp(suffix, "_MODEL_INFO_") == 0) {
-                model_num++;
-            }
+// Hash of the name, size and mtime of the _MODEL_INFO_ file of num NUL-separated model names.
+// A missing file hashes as size -1, so a removed model never matches.
+static uint32_t spiffs_manifest_hash(const char *base_path, const char *names, int num)
+{
+    uint32_t h = 2166136261u;
+    char path[128];
+    for (int i = 0; i < num; i++) {
+        struct stat st;
+        int32_t size = -1;
+        int32_t mtime = 0;
+        snprintf(path, sizeof(path), "%s/%s%s", base_path, names, SRMODEL_INFO_SUFFIX);
+        if (stat(path, &st) == 0) {
+            size = (int32_t)st.st_size;
+            mtime = (int32_t)st.st_mtime;
         }
+        h = spiffs_manifest_hash_bytes(h, names, strlen(names) + 1);
+        h = spiffs_manifest_hash_bytes(h, &size, sizeof(size));
+        h = spiffs_manifest_hash_bytes(h, &mtime, sizeof(mtime));
+        names += strlen(names) + 1;
+    }
+    return h;
+}
 
-        // allocate model names
-        if (model_num == 0) {
-            return models;
-        } else {
-            models->num = model_num;
-            models->model_name = malloc(models->num * sizeof(char *));
-            for (int i = 0; i < models->num; i++) {
-                models->model_name[i] = (char *)calloc(MODEL_NAME_MAX_LENGTH, sizeof(char));
-            }
+// Model names from a manifest written for a filesystem of this total/used size whose models
+// still hash the same, or NULL if there is none or it is stale
+static char *spiffs_manifest_read(const char *base_path, const char *path, size_t total, size_t used, size_t *len,
+                                  int *num)
+{
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return NULL;
+    }
+
+    char *buf = (char *)malloc(SRMODEL_MANIFEST_MAX);
+    size_t size = buf ? fread(buf, 1, SRMODEL_MANIFEST_MAX - 1, fp) : 0;
+    fclose(fp);
+    if (size == 0) {
+        free(buf);
+        return NULL;
+    }
+    buf[size] = '\0';
+
+    unsigned version = 0;
+    unsigned long m_total = 0, m_used = 0, m_hash = 0;
+    int header_len = 0;
+    if (sscanf(buf, "SRMF %u %lx %lx %lx\n%n", &version, &m_total, &m_used, &m_hash, &header_len) != 4 ||
+        header_len == 0 || version != SRMODEL_MANIFEST_VERSION || m_total != total || m_used != used) {
+        free(buf);
+        return NULL;
+    }
+
+    // turn the name lines into NUL-separated names in place
+    *len = 0;
+    *num = 0;
+    char *line = buf + header_len;
+    while (*line != '\0') {
+        char *end = strchr(line, '\n');
+        if (end == NULL) {
+            break; // truncated, written incompletely
         }
+        size_t name_len = end - line;
+        memmove(buf + *len, line, name_len);
+        buf[*len + name_len] = '\0';
+        *len += name_len + 1;
+        (*num)++;
+        line = end + 1;
+    }
+    if (*line != '\0' || spiffs_manifest_hash(base_path, buf, *num) != m_hash) {
+        free(buf);
+        return NULL;
+    }
+    return buf;
+}
 
-        // read & save model names
-        closedir(dir);
-        dir = opendir(conf->base_path);
-        while ((ret = readdir(dir)) != NULL) {
-            // NULL if reach the end of directory
+// Save the scanned names. The used byte count is only known once the manifest itself is on
+// the filesystem, so it is patched into the fixed-width header field afterwards.
+static void spiffs_manifest_write(const char *base_path, const char *path, const char *label, const char *names,
+                                  size_t len, int num)
+{
+    if (len + 64 > SRMODEL_MANIFEST_MAX) {
+        return;
+    }
+    unsigned long hash = spiffs_manifest_hash(base_path, names, num);
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        ESP_LOGW(TAG, "Can not write %s", path);
+        return;
+    }
+    fprintf(fp, "SRMF %u %08lx %08lx %08lx\n", SRMODEL_MANIFEST_VERSION, 0UL, 0UL, hash);
+    for (int i = 0; i < num; i++) {
+        fprintf(fp, "%s\n", names);
+        names += strlen(names) + 1;
+    }
+    fclose(fp);
 
-            if (ret->d_type == DT_DIR) { // continue if d_type is not file
-                continue;
-            }
+    size_t total = 0, used = 0;
+    if (esp_spiffs_info(label, &total, &used) != ESP_OK || (fp = fopen(path, "r+")) == NULL) {
+        unlink(path);
+        return;
+    }
+    fprintf(fp, "SRMF %u %08lx %08lx %08lx\n", SRMODEL_MANIFEST_VERSION, (unsigned long)total, (unsigned long)used,
+            hash);
+    fclose(fp);
+}
+#endif
+
+srmodel_list_t *read_models_form_spiffs(esp_vfs_spiffs_conf_t *conf)
+{
+    if (static_srmodels == NULL) {
+        static_srmodels = srmodel_list_alloc();
+    } else {
+        return static_srmodels;
+    }
 
-            int len = strlen(ret->d_name);
-            char *suffix = ret->d_name + len - 12;
+    srmodel_list_t *models = static_srmodels;
 
-            if (strcmp(suffix, "_MODEL_INFO_") == 0) {
-                memcpy(models->model_name[idx], ret->d_name, (len - 13) * sizeof(char));
-                // models->model_name[idx][len-13] = '\0';
-                idx++;
-            }
+    size_t len = 0;
+    int model_num = 0;
+#if CONFIG_MODEL_SPIFFS_MANIFEST
+    char manifest[64];
+    snprintf(manifest, sizeof(manifest), "%s/%s", conf->base_path, SRMODEL_MANIFEST_NAME);
+
+    size_t total = 0, used = 0;
+    int have_info = esp_spiffs_info(conf->partition_label, &total, &used) == ESP_OK;
+
+    char *names = have_info ? spiffs_manifest_read(conf->base_path, manifest, total, used, &len, &model_num) : NULL;
+    if (names != NULL) {
+        ESP_LOGI(TAG, "Using cached model list (%d models)", model_num);
+    } else {
+        names = spiffs_scan_models(conf->base_path, &len, &model_num);
+        if (names != NULL && have_info) {
+            spiffs_manifest_write(conf->base_path, manifest, conf->partition_label, names, len, model_num);
         }
-        closedir(dir);
-        dir = NULL;
     }
+#else
+    char *names = spiffs_scan_models(conf->base_path, &len, &model_num);
+#endif
+
+    if (names != NULL && model_num > 0) {
+        spiffs_set_model_names(models, names, len, model_num);
+    }
+    free(names);
     return models;
 }
 
@@ -212,6 +492,7 @@ srmodel_list_t *srmodel_spiffs_init(const esp_partition_t *part)
     // Read all model from path
     srmodel_list_t *models = read_models_form_spiffs(&conf);
     models->partition = (esp_partition_t *)part;
+    srmodel_index_build(models);
     return models;
 }
 
@@ -227,28 +508,32 @@ void srmodel_spiffs_deinit(srmodel_list_t *models)
     }
 
     if (models != NULL) {
-        if (models->num > 0) {
-            for (int i = 0; i < models->num; i++) {
-                free(models->model_name[i]);
-            }
-            free(models->model_name);
+        srmodel_index_free();
+        // the names live in the same allocation as the pointer array
+        free(models->model_name);
+        if (models == static_srmodels) {
+            static_srmodels = NULL;
         }
         free(models);
     }
     models = NULL;
 }
 
-static uint32_t read_int32(char *data)
+// All bookkeeping of srmodel_load() lives in one allocation. File names and data pointers
+// reference the mapped partition directly; only model info strings (which are not NUL
+// terminated in the pack) and names that fill all SRMODEL_STRING_LENGTH bytes are copied.
+static void *srmodel_arena = NULL;
+
+static char *arena_take(char **cursor, size_t size)
 {
-    uint32_t value = 0;
-    value |= data[0] << 0;
-    value |= data[1] << 8;
-    value |= data[2] << 16;
-    value |= data[3] << 24;
-    return value;
+    char *p = *cursor;
+    *cursor += (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    return p;
 }
 
-srmodel_list_t *srmodel_load(const void *root)
+// Parse a pack header. File data pointers are base + offset, or NULL until the model is
+// acquired when base is NULL (lazy mapping).
+static srmodel_list_t *srmodel_parse(const char *header, const char *base)
 {
     if (static_srmodels == NULL) {
         static_srmodels = srmodel_list_alloc();
@@ -256,57 +541,404 @@ srmodel_list_t *srmodel_load(const void *root)
     }
 
     srmodel_list_t *models = static_srmodels;
-    char *start = (char *)root;
-    char *data = (char *)root;
+    char *start = (char *)base;
+    const char *table = srmodel_pack_table(header);
     int str_len = SRMODEL_STRING_LENGTH;
-    int int_len = 4;
-    // read model number
-    models->num = read_int32(data);
-    data += int_len;
-    models->model_data = (srmodel_data_t **)malloc(sizeof(srmodel_data_t *) * models->num);
-    models->model_name = (char **)malloc(sizeof(char *) * models->num);
-    models->model_info = (char **)malloc(sizeof(char *) * models->num);
+    int model_num = srmodel_pack_u32(table);
+    srmodel_pack_model_t rec;
+    srmodel_pack_file_t file;
+
+    // first pass over the header: count files and the bytes needed for copied strings
+    int total_files = 0;
+    size_t str_bytes = 0;
+    const char *p = table + 4;
+    for (int i = 0; i < model_num; i++) {
+        p = srmodel_pack_model(p, &rec);
+        if (strnlen(rec.name, str_len) == str_len) {
+            str_bytes += str_len + sizeof(void *);
+        }
+        for (uint32_t j = 0; j < rec.file_num; j++) {
+            p = srmodel_pack_file(p, &file);
+            if (strnlen(file.name, str_len) == str_len) {
+                str_bytes += str_len + sizeof(void *);
+            }
+            if (base != NULL && strncmp(file.name, "_MODEL_INFO_", str_len) == 0) {
+                str_bytes += file.len + sizeof(void *);
+            }
+        }
+        total_files += rec.file_num;
+    }
+
+    size_t ptr_size = sizeof(void *);
+    size_t arena_size = 3 * model_num * ptr_size                                   // model_data, model_name, model_info
+                        + model_num * ((sizeof(srmodel_data_t) + ptr_size - 1) & ~(ptr_size - 1))
+                        + 2 * total_files * ptr_size                               // files, data
+                        + ((total_files * sizeof(int) + ptr_size - 1) & ~(ptr_size - 1)) // sizes
+                        + ((total_files * sizeof(uint32_t) + ptr_size - 1) & ~(ptr_size - 1)) // offsets
+                        + model_num * ((sizeof(srmodel_map_t) + ptr_size - 1) & ~(ptr_size - 1))
+                        + str_bytes;
+    free(srmodel_arena);
+    srmodel_arena = malloc(arena_size);
+    if (srmodel_arena == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %d bytes for the model table", (int)arena_size);
+        models->num = 0;
+        return models;
+    }
 
+    char *cursor = (char *)srmodel_arena;
+    models->num = model_num;
+    models->model_data = (srmodel_data_t **)arena_take(&cursor, model_num * ptr_size);
+    models->model_name = (char **)arena_take(&cursor, model_num * ptr_size);
+    models->model_info = (char **)arena_take(&cursor, model_num * ptr_size);
+    char **files = (char **)arena_take(&cursor, total_files * ptr_size);
+    char **file_data = (char **)arena_take(&cursor, total_files * ptr_size);
+    int *sizes = (int *)arena_take(&cursor, total_files * sizeof(int));
+    uint32_t *offsets = (uint32_t *)arena_take(&cursor, total_files * sizeof(uint32_t));
+    model_maps = (srmodel_map_t *)arena_take(&cursor, model_num * sizeof(srmodel_map_t));
+
+    p = table + 4;
     for (int i = 0; i < models->num; i++) {
-        srmodel_data_t *model_data = (srmodel_data_t *)malloc(sizeof(srmodel_data_t));
+        srmodel_data_t *model_data = (srmodel_data_t *)arena_take(&cursor, sizeof(srmodel_data_t));
         models->model_info[i] = NULL;
+        p = srmodel_pack_model(p, &rec);
         // read model name
-        models->model_name[i] = (char *)malloc((strlen(data) + 1) * sizeof(char));
-        strcpy(models->model_name[i], data);
-        data += str_len;
-        // read model number
-        int file_num = read_int32(data);
+        if (strnlen(rec.name, str_len) < str_len) {
+            models->model_name[i] = (char *)rec.name;
+        } else {
+            models->model_name[i] = arena_take(&cursor, str_len + 1);
+            memcpy(models->model_name[i], rec.name, str_len);
+            models->model_name[i][str_len] = '\0';
+        }
+        int file_num = rec.file_num;
         model_data->num = file_num;
-        data += int_len;
-        model_data->files = (char **)malloc(sizeof(char *) * file_num);
-        model_data->data = (char **)malloc(sizeof(void *) * file_num);
-        model_data->sizes = (int *)malloc(sizeof(int) * file_num);
+        model_data->files = files;
+        model_data->data = file_data;
+        model_data->sizes = sizes;
+        model_maps[i].offsets = offsets;
+        model_maps[i].refs = 0;
+        model_maps[i].pinned = false;
+        model_maps[i].map_handle = NULL;
+        files += file_num;
+        file_data += file_num;
+        sizes += file_num;
+        offsets += file_num;
 
         for (int j = 0; j < file_num; j++) {
-            // read file name
-            model_data->files[j] = data;
-            data += str_len;
-            // read file start index
-            int index = read_int32(data);
-            data += int_len;
-            model_data->data[j] = start + index;
-            // read file size
-            int size = read_int32(data);
-            data += int_len;
-            model_data->sizes[j] = size;
-
-            // read model info
-            if (strcmp(model_data->files[j], "_MODEL_INFO_") == 0) {
-                models->model_info[i] = get_model_info(model_data->data[j], model_data->sizes[j]);
+            p = srmodel_pack_file(p, &file);
+            if (strnlen(file.name, str_len) < str_len) {
+                model_data->files[j] = (char *)file.name;
+            } else {
+                model_data->files[j] = arena_take(&cursor, str_len + 1);
+                memcpy(model_data->files[j], file.name, str_len);
+                model_data->files[j][str_len] = '\0';
+            }
+            model_maps[i].offsets[j] = file.start;
+            model_data->data[j] = start ? start + file.start : NULL;
+            model_data->sizes[j] = file.len;
+
+            // read model info (lazy mode reads it from flash once the header is parsed)
+            if (start != NULL && strncmp(model_data->files[j], "_MODEL_INFO_", str_len) == 0) {
+                models->model_info[i] = get_model_info_to(model_data->data[j], model_data->sizes[j],
+                                                          arena_take(&cursor, file.len + 1));
             }
         }
         models->model_data[i] = model_data;
     }
+    srmodel_index_build(models);
     ESP_LOGI(TAG, "Successfully load srmodels");
     set_model_base_path(NULL);
     return models;
 }
 
+srmodel_list_t *srmodel_load(const void *root)
+{
+    return srmodel_parse((const char *)root, (const char *)root);
+}
+
+// Drop the model list after a failed load so esp_srmodel_init() reports the error
+static void srmodel_list_discard(void)
+{
+    srmodel_index_free();
+    free(srmodel_arena);
+    srmodel_arena = NULL;
+    model_maps = NULL;
+    if (static_srmodels != NULL) {
+        free(static_srmodels->mmap_handle);
+        free(static_srmodels);
+        static_srmodels = NULL;
+    }
+}
+
+// CRC32 of a file, from the mapped partition when root is given, else read in chunks
+static int srmodel_file_crc(const esp_partition_t *partition, const char *root, uint32_t start, uint32_t len,
+                            uint32_t *crc)
+{
+    if (root != NULL) {
+        *crc = esp_rom_crc32_le(0, (const uint8_t *)root + start, len);
+        return 0;
+    }
+
+    const uint32_t chunk = 4096;
+    uint8_t *buf = (uint8_t *)malloc(chunk);
+    if (buf == NULL) {
+        return -1;
+    }
+    uint32_t c = 0;
+    for (uint32_t off = 0; off < len; off += chunk) {
+        uint32_t n = len - off < chunk ? len - off : chunk;
+        if (esp_partition_read(partition, start + off, buf, n) != ESP_OK) {
+            free(buf);
+            return -1;
+        }
+        c = esp_rom_crc32_le(c, buf, n);
+    }
+    free(buf);
+    *crc = c;
+    return 0;
+}
+
+#if SRMODEL_USE_NVS
+#define SRMODEL_NVS_NAMESPACE "srmodel"
+#define SRMODEL_NVS_VERIFIED  "verified"    // fingerprint of the last fully verified pack header
+#define SRMODEL_NVS_STAGED    "sd_staged"   // fingerprint of the SD card files last staged to flash
+
+static int srmodel_nvs_get(const char *key, uint32_t *value)
+{
+    nvs_handle_t nvs;
+    if (nvs_open(SRMODEL_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return -1;
+    }
+    esp_err_t err = nvs_get_u32(nvs, key, value);
+    nvs_close(nvs);
+    return err == ESP_OK ? 0 : -1;
+}
+
+static void srmodel_nvs_set(const char *key, uint32_t value)
+{
+    nvs_handle_t nvs;
+    if (nvs_open(SRMODEL_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        ESP_LOGW(TAG, "NVS not available, %s will not be remembered", key);
+        return;
+    }
+    if (nvs_set_u32(nvs, key, value) == ESP_OK) {
+        nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+}
+
+static void srmodel_nvs_erase(const char *key)
+{
+    nvs_handle_t nvs;
+    if (nvs_open(SRMODEL_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        return;
+    }
+    if (nvs_erase_key(nvs, key) == ESP_OK) {
+        nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+}
+#endif
+
+// Validate a pack before it is used. The header is always bounds-checked; with
+// CONFIG_MODEL_VERIFY every file of a v2 pack is checked against its CRC unless NVS records
+// that this exact header (which includes all file CRCs) at this partition already passed.
+static int srmodel_validate(const esp_partition_t *partition, const char *hdr, uint32_t hdr_len, const char *root)
+{
+    srmodel_pack_t pack;
+    int err = srmodel_pack_open(&pack, hdr, hdr_len, partition->size);
+    if (err != SRMODEL_PACK_OK) {
+        ESP_LOGE(TAG, "Model pack in %s: %s", partition->label, srmodel_pack_strerror(err));
+        return -1;
+    }
+    if (pack.crcs == NULL) {
+        ESP_LOGW(TAG, "Unversioned model pack in %s, file checksums not available", partition->label);
+        return 0;
+    }
+
+#if CONFIG_MODEL_VERIFY
+#if CONFIG_MODEL_VERIFY_NVS_CACHE
+    uint32_t where[2] = {partition->address, partition->size};
+    uint32_t fingerprint = esp_rom_crc32_le(pack.header_crc, (const uint8_t *)where, sizeof(where));
+    uint32_t stored = 0;
+    if (srmodel_nvs_get(SRMODEL_NVS_VERIFIED, &stored) == 0 && stored == fingerprint) {
+        ESP_LOGI(TAG, "Model pack in %s verified on an earlier boot", partition->label);
+        return 0;
+    }
+#endif
+
+    const char *p = pack.table + 4;
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < pack.model_num; i++) {
+        srmodel_pack_model_t model;
+        p = srmodel_pack_model(p, &model);
+        for (uint32_t j = 0; j < model.file_num; j++, index++) {
+            srmodel_pack_file_t file;
+            uint32_t crc = 0;
+            p = srmodel_pack_file(p, &file);
+            if (srmodel_file_crc(partition, root, file.start, file.len, &crc) != 0) {
+                ESP_LOGE(TAG, "Failed to read model file %.32s", file.name);
+                return -1;
+            }
+            if (crc != srmodel_pack_file_crc(&pack, index)) {
+                ESP_LOGE(TAG, "Checksum mismatch in model file %.32s", file.name);
+                return -1;
+            }
+        }
+    }
+    ESP_LOGI(TAG, "Model pack in %s verified", partition->label);
+#if CONFIG_MODEL_VERIFY_NVS_CACHE
+    srmodel_nvs_set(SRMODEL_NVS_VERIFIED, fingerprint);
+#endif
+#else
+    (void)root;
+#endif
+    return 0;
+}
+
+#if SRMODEL_LAZY_MMAP
+// Append len bytes at partition offset off to the heap header copy
+static int lazy_header_read(const esp_partition_t *partition, uint32_t *len, uint32_t n)
+{
+    if (*len + n > partition->size) {
+        ESP_LOGE(TAG, "Model header runs past the end of %s", partition->label);
+        return -1;
+    }
+    char *buf = (char *)realloc(lazy_header, *len + n);
+    if (buf == NULL) {
+        return -1;
+    }
+    lazy_header = buf;
+    if (esp_partition_read(partition, *len, lazy_header + *len, n) != ESP_OK) {
+        return -1;
+    }
+    *len += n;
+    return 0;
+}
+
+// Read only the pack header from flash and parse it; nothing is mapped until a model is acquired
+static srmodel_list_t *srmodel_lazy_init(const esp_partition_t *partition)
+{
+    uint32_t len = 0;
+    if (lazy_header_read(partition, &len, 4) != 0) {
+        goto err;
+    }
+    if (srmodel_pack_u32(lazy_header) == SRMODEL_PACK_MAGIC) {
+        // v2 knows its header length, fetch it in one read
+        if (lazy_header_read(partition, &len, SRMODEL_PACK_PREFIX_LEN - 4) != 0) {
+            goto err;
+        }
+        uint32_t header_len = srmodel_pack_u32(lazy_header + 8);
+        if (header_len < len || lazy_header_read(partition, &len, header_len - len) != 0) {
+            goto err;
+        }
+    } else {
+        int model_num = srmodel_pack_u32(lazy_header);
+        for (int i = 0; i < model_num; i++) {
+            if (lazy_header_read(partition, &len, SRMODEL_STRING_LENGTH + 4) != 0) {
+                goto err;
+            }
+            uint32_t file_num = srmodel_pack_u32(lazy_header + len - 4);
+            if (file_num > partition->size / (SRMODEL_STRING_LENGTH + 8) ||
+                lazy_header_read(partition, &len, file_num * (SRMODEL_STRING_LENGTH + 8)) != 0) {
+                goto err;
+            }
+        }
+    }
+
+    if (srmodel_validate(partition, lazy_header, len, NULL) != 0) {
+        free(lazy_header);
+        lazy_header = NULL;
+        srmodel_list_discard();
+        return NULL;
+    }
+
+    srmodel_list_t *models = srmodel_parse(lazy_header, NULL);
+    models->partition = (esp_partition_t *)partition;
+
+    // model info is tiny, read it directly instead of mapping the model
+    for (int i = 0; i < models->num; i++) {
+        srmodel_data_t *model_data = models->model_data[i];
+        for (int j = 0; j < model_data->num; j++) {
+            if (strncmp(model_data->files[j], "_MODEL_INFO_", SRMODEL_STRING_LENGTH) != 0) {
+                continue;
+            }
+            char *info = (char *)malloc(model_data->sizes[j] + 1);
+            if (info && esp_partition_read(partition, model_maps[i].offsets[j], info, model_data->sizes[j]) == ESP_OK) {
+                models->model_info[i] = get_model_info(info, model_data->sizes[j]);
+            }
+            free(info);
+        }
+    }
+    ESP_LOGI(TAG, "Lazy model mapping: read %ld byte header of %s", (long)len, partition->label);
+    return models;
+
+err:
+    ESP_LOGE(TAG, "Failed to read model header from %s", partition->label);
+    free(lazy_header);
+    lazy_header = NULL;
+    srmodel_list_discard();
+    return NULL;
+}
+
+// Map the span of partition holding all files of model i
+static int srmodel_map_model(srmodel_list_t *models, int i)
+{
+    srmodel_data_t *model_data = models->model_data[i];
+    srmodel_map_t *map = &model_maps[i];
+    if (model_data->num == 0) {
+        return 0;
+    }
+
+    uint32_t lo = UINT32_MAX, hi = 0;
+    for (int j = 0; j < model_data->num; j++) {
+        uint32_t end = map->offsets[j] + model_data->sizes[j];
+        if (map->offsets[j] < lo) {
+            lo = map->offsets[j];
+        }
+        if (end > hi) {
+            hi = end;
+        }
+    }
+    if (hi > models->partition->size) {
+        ESP_LOGE(TAG, "%s runs past the end of the model partition", models->model_name[i]);
+        return -1;
+    }
+
+    int free_pages = spi_flash_mmap_get_free_pages(ESP_PARTITION_MMAP_DATA);
+    ESP_LOGI(TAG, "Mapping %s: %ld KB, %d free MMU pages", models->model_name[i], (long)(hi - lo) / 1024, free_pages);
+
+    const void *base = NULL;
+    esp_partition_mmap_handle_t *handle = (esp_partition_mmap_handle_t *)malloc(sizeof(esp_partition_mmap_handle_t));
+    if (handle == NULL) {
+        return -1;
+    }
+    if (esp_partition_mmap(models->partition, lo, hi - lo, ESP_PARTITION_MMAP_DATA, &base, handle) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map %s", models->model_name[i]);
+        free(handle);
+        return -1;
+    }
+    for (int j = 0; j < model_data->num; j++) {
+        model_data->data[j] = (char *)base + (map->offsets[j] - lo);
+    }
+    map->map_handle = handle;
+    return 0;
+}
+
+static void srmodel_unmap_model(srmodel_list_t *models, int i)
+{
+    srmodel_map_t *map = &model_maps[i];
+    if (map->map_handle == NULL) {
+        return;
+    }
+    esp_partition_munmap(*(esp_partition_mmap_handle_t *)map->map_handle);
+    free(map->map_handle);
+    map->map_handle = NULL;
+    for (int j = 0; j < models->model_data[i]->num; j++) {
+        models->model_data[i]->data[j] = NULL;
+    }
+}
+#endif
+
 srmodel_list_t *srmodel_mmap_init(const esp_partition_t *partition)
 {
     if (static_srmodels == NULL) {
@@ -315,6 +947,9 @@ srmodel_list_t *srmodel_mmap_init(const esp_partition_t *partition)
         return static_srmodels;
     }
 
+#if SRMODEL_LAZY_MMAP
+    return srmodel_lazy_init(partition);
+#else
     srmodel_list_t *models = static_srmodels;
     const void *root;
 
@@ -341,9 +976,21 @@ srmodel_list_t *srmodel_mmap_init(const esp_partition_t *partition)
     ESP_ERROR_CHECK(esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &root, models->mmap_handle));
 #endif
 
+    if (srmodel_validate(partition, root, partition->size, root) != 0) {
+        ESP_LOGE(TAG, "Model partition %s failed validation", partition->label);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        esp_partition_munmap(*(esp_partition_mmap_handle_t *)models->mmap_handle);
+#else
+        spi_flash_munmap(*(spi_flash_mmap_handle_t *)models->mmap_handle);
+#endif
+        srmodel_list_discard();
+        return NULL;
+    }
+
     models->partition = (esp_partition_t *)partition;
     srmodel_load(root);
     return models;
+#endif
 }
 
 void srmodel_mmap_deinit(srmodel_list_t *models)
@@ -357,21 +1004,22 @@ void srmodel_mmap_deinit(srmodel_list_t *models)
 #endif
         }
 
-        if (models->num > 0) {
-            for (int i = 0; i < models->num; i++) {
-                free(models->model_data[i]->files);
-                free(models->model_data[i]->data);
-                free(models->model_data[i]->sizes);
-                free(models->model_data[i]);
-                free(models->model_name[i]);
-                if (models->model_info[i] != NULL)
-                    free(models->model_info[i]);
-            }
+        _lock_acquire(&model_maps_lock);
+#if SRMODEL_LAZY_MMAP
+        for (int i = 0; model_maps != NULL && i < models->num; i++) {
+            srmodel_unmap_model(models, i);
+            free(models->model_info[i]);
         }
-        free(models->model_data);
-        free(models->model_name);
+        free(lazy_header);
+        lazy_header = NULL;
+#endif
+        // the model table lives in srmodel_arena and points into the unmapped region
+        srmodel_index_free();
+        model_maps = NULL;
+        _lock_release(&model_maps_lock);
+        free(srmodel_arena);
+        srmodel_arena = NULL;
         free(models->mmap_handle);
-        free(models->model_info);
         free(models);
     }
     models = NULL;
@@ -385,8 +1033,58 @@ char *get_model_base_path(void)
     return SRMODE_BASE_PATH;
 }
 
+// Take a reference to model i, mapping it on the first one. Called with model_maps_lock held.
+static int srmodel_ref(srmodel_list_t *models, int i)
+{
+#if SRMODEL_LAZY_MMAP
+    if (model_maps[i].refs == 0 && srmodel_map_model(models, i) != 0) {
+        return -1;
+    }
+#endif
+    model_maps[i].refs++;
+    return 0;
+}
+
+// Drop a reference to model i, unmapping it with the last one. Called with model_maps_lock held.
+static void srmodel_unref(srmodel_list_t *models, int i)
+{
+    if (--model_maps[i].refs == 0) {
+#if SRMODEL_LAZY_MMAP
+        srmodel_unmap_model(models, i);
+#endif
+    }
+}
+
+// A model handed out by name may be created without esp_srmodel_acquire(), so it is pinned:
+// it holds one implicit reference until esp_srmodel_acquire() takes that reference over or the
+// list is deinitialized. Called with model_maps_lock held.
+static void srmodel_pin(srmodel_list_t *models, int i)
+{
+    if (models != static_srmodels || model_maps == NULL || model_maps[i].pinned) {
+        return;
+    }
+    if (srmodel_ref(models, i) == 0) {
+        model_maps[i].pinned = true;
+    } else {
+        ESP_LOGE(TAG, "Failed to map %s", models->model_name[i]);
+    }
+}
+
 srmodel_list_t *get_static_srmodels(void)
 {
+#if SRMODEL_LAZY_MMAP
+    // The list is also handed to model creation by callers that never look a model up,
+    // e.g. afe_config_init(). If nothing is mapped at all, none of them acquired anything.
+    _lock_acquire(&model_maps_lock);
+    bool mapped = false;
+    for (int i = 0; static_srmodels != NULL && model_maps != NULL && i < static_srmodels->num; i++) {
+        mapped |= model_maps[i].refs > 0;
+    }
+    for (int i = 0; !mapped && static_srmodels != NULL && model_maps != NULL && i < static_srmodels->num; i++) {
+        srmodel_pin(static_srmodels, i);
+    }
+    _lock_release(&model_maps_lock);
+#endif
     return static_srmodels;
 }
 
@@ -492,12 +1190,14 @@ srmodel_list_t *srmodel_sdcard_init(const char *base_path)
         closedir(dir);
         dir = NULL;
     }
+    srmodel_index_build(models);
     return models;
 }
 
 void srmodel_sdcard_deinit(srmodel_list_t *models)
 {
     if (models != NULL) {
+        srmodel_index_free();
         if (models->num > 0) {
             for (int i = 0; i < models->num; i++) {
                 free(models->model_name[i]);
@@ -509,13 +1209,257 @@ void srmodel_sdcard_deinit(srmodel_list_t *models)
     models = NULL;
 }
 
+#if defined(ESP_PLATFORM) && CONFIG_MODEL_SDCARD_STAGING
+typedef struct {
+    char name[SRMODEL_STRING_LENGTH];
+    int model;                  // index into the model name table
+    uint32_t size;
+    uint32_t start;             // offset in the staged pack
+    uint32_t crc;
+} sd_stage_file_t;
+
+typedef struct {
+    char (*models)[SRMODEL_STRING_LENGTH];
+    int model_num;
+    sd_stage_file_t *files;
+    int file_num;
+    int file_cap;
+} sd_stage_list_t;
+
+static int sd_stage_add_file(sd_stage_list_t *list, int model, const char *name, uint32_t size)
+{
+    if (list->file_num == list->file_cap) {
+        int cap = list->file_cap ? list->file_cap * 2 : 16;
+        sd_stage_file_t *files = (sd_stage_file_t *)realloc(list->files, cap * sizeof(sd_stage_file_t));
+        if (files == NULL) {
+            return -1;
+        }
+        list->files = files;
+        list->file_cap = cap;
+    }
+    sd_stage_file_t *f = &list->files[list->file_num++];
+    memset(f, 0, sizeof(*f));
+    strncpy(f->name, name, SRMODEL_STRING_LENGTH);
+    f->model = model;
+    f->size = size;
+    return 0;
+}
+
+// List every <base>/<model>/<file> of the models that have a _MODEL_INFO_ file, folding
+// name, size and mtime of each file into *fingerprint
+static int sd_stage_scan(const char *base_path, sd_stage_list_t *list, uint32_t *fingerprint)
+{
+    DIR *dir = opendir(base_path);
+    if (dir == NULL) {
+        return -1;
+    }
+
+    struct dirent *ent;
+    uint32_t fp = 0;
+    while ((ent = readdir(dir)) != NULL) {
+        if (ent->d_type != DT_DIR || ent->d_name[0] == '.' || strlen(ent->d_name) >= SRMODEL_STRING_LENGTH) {
+            continue;
+        }
+        char *sub_path = join_path(base_path, ent->d_name);
+        char *info_file = join_path(sub_path, "_MODEL_INFO_");
+        struct stat st;
+        DIR *sub = stat(info_file, &st) == 0 ? opendir(sub_path) : NULL;
+        free(info_file);
+        if (sub == NULL) {
+            free(sub_path);
+            continue;
+        }
+
+        void *models = realloc(list->models, (list->model_num + 1) * SRMODEL_STRING_LENGTH);
+        if (models == NULL) {
+            closedir(sub);
+            free(sub_path);
+            closedir(dir);
+            return -1;
+        }
+        list->models = models;
+        memset(list->models[list->model_num], 0, SRMODEL_STRING_LENGTH);
+        strcpy(list->models[list->model_num], ent->d_name);
+        fp = esp_rom_crc32_le(fp, (const uint8_t *)ent->d_name, strlen(ent->d_name));
+
+        struct dirent *fent;
+        while ((fent = readdir(sub)) != NULL) {
+            if (fent->d_type == DT_DIR || strlen(fent->d_name) >= SRMODEL_STRING_LENGTH) {
+                continue;
+            }
+            char *file_path = join_path(sub_path, fent->d_name);
+            int ok = stat(file_path, &st) == 0;
+            free(file_path);
+            if (!ok || sd_stage_add_file(list, list->model_num, fent->d_name, (uint32_t)st.st_size) != 0) {
+                continue;
+            }
+            uint32_t meta[2] = {(uint32_t)st.st_size, (uint32_t)st.st_mtime};
+            fp = esp_rom_crc32_le(fp, (const uint8_t *)fent->d_name, strlen(fent->d_name));
+            fp = esp_rom_crc32_le(fp, (const uint8_t *)meta, sizeof(meta));
+        }
+        closedir(sub);
+        free(sub_path);
+        list->model_num++;
+    }
+    closedir(dir);
+    *fingerprint = fp;
+    return 0;
+}
+
+// Copy the SD card models into partition as a v2 pack, streaming each file through a small
+// buffer. The header is written last, so an interrupted copy leaves an invalid pack that is
+// rejected at load and staged again on the next boot.
+static int sd_stage_write(const char *base_path, sd_stage_list_t *list, const esp_partition_t *partition)
+{
+    int str_len = SRMODEL_STRING_LENGTH;
+    uint32_t header_len = SRMODEL_PACK_PREFIX_LEN + 4 + list->model_num * (str_len + 4) + list->file_num * (str_len + 12);
+    uint32_t total = header_len;
+    for (int i = 0; i < list->file_num; i++) {
+        list->files[i].start = total;
+        total += list->files[i].size;
+    }
+    if (total > partition->size) {
+        ESP_LOGE(TAG, "SD card models need %ld KB, %s holds %ld KB", (long)total / 1024, partition->label,
+                 (long)partition->size / 1024);
+        return -1;
+    }
+
+    const uint32_t chunk = 4096;
+    char *buf = (char *)malloc(chunk > header_len ? chunk : header_len);
+    if (buf == NULL) {
+        return -1;
+    }
+    if (esp_partition_erase_range(partition, 0, (total + 4095) & ~4095) != ESP_OK) {
+        free(buf);
+        return -1;
+    }
+
+    for (int i = 0; i < list->file_num; i++) {
+        sd_stage_file_t *f = &list->files[i];
+        char *sub_path = join_path(base_path, list->models[f->model]);
+        char *file_path = join_path(sub_path, f->name);
+        FILE *fp = fopen(file_path, "rb");
+        free(sub_path);
+        free(file_path);
+        if (fp == NULL) {
+            free(buf);
+            return -1;
+        }
+        uint32_t done = 0;
+        while (done < f->size) {
+            size_t n = fread(buf, 1, f->size - done < chunk ? f->size - done : chunk, fp);
+            if (n == 0 || esp_partition_write(partition, f->start + done, buf, n) != ESP_OK) {
+                break;
+            }
+            f->crc = esp_rom_crc32_le(f->crc, (const uint8_t *)buf, n);
+            done += n;
+        }
+        fclose(fp);
+        if (done != f->size) {
+            ESP_LOGE(TAG, "Failed to stage %s/%s", list->models[f->model], f->name);
+            free(buf);
+            return -1;
+        }
+    }
+
+    // model table in model order, files of each model contiguous, then the CRC table
+    char *p = buf + SRMODEL_PACK_PREFIX_LEN;
+    char *crc_p = buf + header_len - list->file_num * 4;
+    memset(buf, 0, header_len);
+    srmodel_pack_put_u32(p, list->model_num);
+    p += 4;
+    for (int m = 0; m < list->model_num; m++) {
+        memcpy(p, list->models[m], str_len);
+        char *count = p + str_len;
+        p += str_len + 4;
+        uint32_t n = 0;
+        for (int i = 0; i < list->file_num; i++) {
+            if (list->files[i].model != m) {
+                continue;
+            }
+            memcpy(p, list->files[i].name, str_len);
+            srmodel_pack_put_u32(p + str_len, list->files[i].start);
+            srmodel_pack_put_u32(p + str_len + 4, list->files[i].size);
+            srmodel_pack_put_u32(crc_p, list->files[i].crc);
+            p += str_len + 8;
+            crc_p += 4;
+            n++;
+        }
+        srmodel_pack_put_u32(count, n);
+    }
+    srmodel_pack_put_u32(buf, SRMODEL_PACK_MAGIC);
+    srmodel_pack_put_u32(buf + 4, SRMODEL_PACK_VERSION);
+    srmodel_pack_put_u32(buf + 8, header_len);
+    srmodel_pack_put_u32(buf + 12, esp_rom_crc32_le(0, (const uint8_t *)buf + SRMODEL_PACK_PREFIX_LEN,
+                                                    header_len - SRMODEL_PACK_PREFIX_LEN));
+    esp_err_t err = esp_partition_write(partition, 0, buf, header_len);
+    free(buf);
+    return err == ESP_OK ? 0 : -1;
+}
+
+// Stage the SD card models into flash if they changed since the last boot, then map them
+static srmodel_list_t *srmodel_sdcard_stage_init(const char *base_path)
+{
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                                CONFIG_MODEL_SDCARD_STAGING_PARTITION);
+    if (partition == NULL) {
+        ESP_LOGE(TAG, "Can not find staging partition %s", CONFIG_MODEL_SDCARD_STAGING_PARTITION);
+        return NULL;
+    }
+
+    sd_stage_list_t list = {0};
+    uint32_t fingerprint = 0;
+    if (sd_stage_scan(base_path, &list, &fingerprint) != 0) {
+        ESP_LOGE(TAG, "Can not read models from %s", base_path);
+        free(list.models);
+        free(list.files);
+        return NULL;
+    }
+    uint32_t where[2] = {partition->address, partition->size};
+    fingerprint = esp_rom_crc32_le(fingerprint, (const uint8_t *)where, sizeof(where));
+
+    srmodel_list_t *models = NULL;
+    uint32_t staged = 0;
+    if (srmodel_nvs_get(SRMODEL_NVS_STAGED, &staged) == 0 && staged == fingerprint) {
+        ESP_LOGI(TAG, "SD card models unchanged, using %s", partition->label);
+        models = srmodel_mmap_init(partition);
+        if (models == NULL) {
+            // the partition was overwritten or corrupted since it was staged
+            ESP_LOGW(TAG, "Staged models in %s are invalid, staging them again", partition->label);
+            srmodel_nvs_erase(SRMODEL_NVS_STAGED);
+        }
+    }
+    if (models == NULL) {
+        ESP_LOGI(TAG, "Staging %d models from %s into %s", list.model_num, base_path, partition->label);
+        if (sd_stage_write(base_path, &list, partition) != 0) {
+            ESP_LOGE(TAG, "Staging models into %s failed", partition->label);
+        } else {
+            models = srmodel_mmap_init(partition);
+        }
+        // only remembered once the staged copy has passed validation
+        if (models != NULL) {
+            srmodel_nvs_set(SRMODEL_NVS_STAGED, fingerprint);
+        }
+    }
+    free(list.models);
+    free(list.files);
+
+    return models;
+}
+#endif
+
 srmodel_list_t *esp_srmodel_init(const char *partition_label)
 {
 #ifdef ESP_PLATFORM
 
 #ifdef CONFIG_MODEL_IN_SDCARD
+#if CONFIG_MODEL_SDCARD_STAGING
+    // Copy model data from SD card into flash once and map it from there
+    return srmodel_sdcard_stage_init(partition_label);
+#else
     // Read model data from SD card
     return srmodel_sdcard_init(partition_label);
+#endif
 #else
     // Read model data from flash partition
     const esp_partition_t *partition = NULL;
@@ -565,6 +1509,9 @@ char *esp_srmodel_filter(srmodel_list_t *models, const char *keyword1, const cha
     for (int i = 0; i < models->num; i++) {
         if (esp_strstr(models->model_name[i], keyword1) != NULL) {
             if (esp_strstr(models->model_name[i], keyword2) != NULL) {
+                _lock_acquire(&model_maps_lock);
+                srmodel_pin(models, i);
+                _lock_release(&model_maps_lock);
                 return models->model_name[i];
             }
         }
@@ -575,29 +1522,71 @@ char *esp_srmodel_filter(srmodel_list_t *models, const char *keyword1, const cha
 
 int esp_srmodel_exists(srmodel_list_t *models, char *model_name)
 {
-    if (models == NULL) {
+    if (models == NULL || model_name == NULL) {
         return -1;
     }
 
-    for (int i = 0; i < models->num; i++) {
-        if (strcmp(models->model_name[i], model_name) == 0) {
-            return i;
-        }
+    int i = srmodel_index_find(models, model_name);
+    if (i >= 0) {
+        _lock_acquire(&model_maps_lock);
+        srmodel_pin(models, i);
+        _lock_release(&model_maps_lock);
     }
-
-    return -1;
+    return i;
 }
 
 char *esp_srmodel_get_wake_words(srmodel_list_t *models, char *model_name)
 {
-    if (models == NULL) {
+    if (models == NULL || model_name == NULL) {
         return NULL;
     }
 
-    for (int i = 0; i < models->num; i++) {
-        if (strcmp(models->model_name[i], model_name) == 0) {
-            return get_wake_words_from_info(models->model_info[i]);
-        }
+    int i = srmodel_index_find(models, model_name);
+    if (i < 0) {
+        return NULL;
     }
-    return NULL;
+    return get_wake_words_from_info(models->model_info[i]);
+}
+
+int esp_srmodel_acquire(srmodel_list_t *models, const char *model_name)
+{
+    if (models == NULL || model_name == NULL) {
+        return -1;
+    }
+    int i = srmodel_index_find(models, model_name);
+    if (i < 0) {
+        return -1;
+    }
+    if (models != static_srmodels || model_maps == NULL) {
+        return 0; // SPIFFS / SD card: files are opened by path, nothing to map
+    }
+
+    int ret = 0;
+    _lock_acquire(&model_maps_lock);
+    if (model_maps[i].pinned) {
+        // the reference taken when the model was handed out becomes the caller's
+        model_maps[i].pinned = false;
+    } else {
+        ret = srmodel_ref(models, i);
+    }
+    _lock_release(&model_maps_lock);
+    return ret;
+}
+
+void esp_srmodel_release(srmodel_list_t *models, const char *model_name)
+{
+    if (models == NULL || model_name == NULL || models != static_srmodels || model_maps == NULL) {
+        return;
+    }
+    int i = srmodel_index_find(models, model_name);
+    if (i < 0) {
+        return;
+    }
+
+    _lock_acquire(&model_maps_lock);
+    // a pinned reference is not the caller's to drop
+    if (model_maps[i].refs > (model_maps[i].pinned ? 1 : 0)) {
+        srmodel_unref(models, i);
+    }
+    _lock_release(&model_maps_lock);
 }
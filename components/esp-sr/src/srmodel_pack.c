@@ -0,0 +1,147 @@
+#include "srmodel_pack.h"
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_rom_crc.h"
+#endif
+
+#ifdef ESP_PLATFORM
+uint32_t srmodel_pack_crc32(uint32_t crc, const void *buf, size_t len)
+{
+    return esp_rom_crc32_le(crc, (const uint8_t *)buf, len);
+}
+#else
+uint32_t srmodel_pack_crc32(uint32_t crc, const void *buf, size_t len)
+{
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+    }
+
+    const uint8_t *p = (const uint8_t *)buf;
+    crc = ~crc;
+    while (len--) {
+        crc = table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+#endif
+
+const char *srmodel_pack_table(const char *hdr)
+{
+    return srmodel_pack_u32(hdr) == SRMODEL_PACK_MAGIC ? hdr + SRMODEL_PACK_PREFIX_LEN : hdr;
+}
+
+const char *srmodel_pack_model(const char *p, srmodel_pack_model_t *model)
+{
+    model->name = p;
+    model->file_num = srmodel_pack_u32(p + SRMODEL_PACK_NAME_LEN);
+    return p + SRMODEL_PACK_MODEL_LEN;
+}
+
+const char *srmodel_pack_file(const char *p, srmodel_pack_file_t *file)
+{
+    file->name = p;
+    file->start = srmodel_pack_u32(p + SRMODEL_PACK_NAME_LEN);
+    file->len = srmodel_pack_u32(p + SRMODEL_PACK_NAME_LEN + 4);
+    return p + SRMODEL_PACK_FILE_LEN;
+}
+
+uint32_t srmodel_pack_file_crc(const srmodel_pack_t *pack, uint32_t index)
+{
+    return pack->crcs ? srmodel_pack_u32(pack->crcs + index * 4) : 0;
+}
+
+int srmodel_pack_open(srmodel_pack_t *pack, const char *hdr, uint32_t hdr_len, uint32_t data_size)
+{
+    const char *p = hdr;
+    const char *end = hdr + hdr_len;
+
+    memset(pack, 0, sizeof(*pack));
+    pack->version = 1;
+    if (hdr_len < 4) {
+        return SRMODEL_PACK_ERR_TRUNCATED;
+    }
+    if (srmodel_pack_u32(p) == SRMODEL_PACK_MAGIC) {
+        if (hdr_len < SRMODEL_PACK_PREFIX_LEN) {
+            return SRMODEL_PACK_ERR_TRUNCATED;
+        }
+        pack->version = srmodel_pack_u32(p + 4);
+        pack->header_len = srmodel_pack_u32(p + 8);
+        pack->header_crc = srmodel_pack_u32(p + 12);
+        if (pack->version != SRMODEL_PACK_VERSION) {
+            return SRMODEL_PACK_ERR_VERSION;
+        }
+        if (pack->header_len > hdr_len || pack->header_len < SRMODEL_PACK_PREFIX_LEN + 4) {
+            return SRMODEL_PACK_ERR_TRUNCATED;
+        }
+        if (srmodel_pack_crc32(0, p + SRMODEL_PACK_PREFIX_LEN, pack->header_len - SRMODEL_PACK_PREFIX_LEN) !=
+            pack->header_crc) {
+            return SRMODEL_PACK_ERR_HEADER_CRC;
+        }
+        end = hdr + pack->header_len;
+        p += SRMODEL_PACK_PREFIX_LEN;
+    }
+
+    pack->table = p;
+    uint32_t model_num = srmodel_pack_u32(p);
+    p += 4;
+    if (model_num > (uint32_t)(end - p) / SRMODEL_PACK_MODEL_LEN) {
+        return SRMODEL_PACK_ERR_TRUNCATED;
+    }
+    uint32_t file_num = 0;
+    for (uint32_t i = 0; i < model_num; i++) {
+        srmodel_pack_model_t model;
+        if (end - p < SRMODEL_PACK_MODEL_LEN) {
+            return SRMODEL_PACK_ERR_TRUNCATED;
+        }
+        p = srmodel_pack_model(p, &model);
+        if (model.file_num > (uint32_t)(end - p) / SRMODEL_PACK_FILE_LEN) {
+            return SRMODEL_PACK_ERR_TRUNCATED;
+        }
+        for (uint32_t j = 0; j < model.file_num; j++) {
+            srmodel_pack_file_t file;
+            p = srmodel_pack_file(p, &file);
+            if (file.start > data_size || file.len > data_size - file.start) {
+                return SRMODEL_PACK_ERR_RANGE;
+            }
+        }
+        file_num += model.file_num;
+    }
+
+    if (pack->version == SRMODEL_PACK_VERSION) {
+        if ((uint32_t)(end - p) != file_num * 4) {
+            return SRMODEL_PACK_ERR_TRUNCATED;
+        }
+        pack->crcs = p;
+    } else {
+        pack->header_len = p - hdr;
+    }
+    pack->model_num = model_num;
+    pack->file_num = file_num;
+    return SRMODEL_PACK_OK;
+}
+
+const char *srmodel_pack_strerror(int err)
+{
+    switch (err) {
+    case SRMODEL_PACK_OK:
+        return "ok";
+    case SRMODEL_PACK_ERR_TRUNCATED:
+        return "header is truncated or corrupted";
+    case SRMODEL_PACK_ERR_VERSION:
+        return "unsupported pack version";
+    case SRMODEL_PACK_ERR_HEADER_CRC:
+        return "header checksum mismatch";
+    case SRMODEL_PACK_ERR_RANGE:
+        return "file lies outside the pack";
+    default:
+        return "unknown error";
+    }
+}
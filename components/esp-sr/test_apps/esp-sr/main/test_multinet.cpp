@@ -21,6 +21,9 @@
 #include <sys/time.h>
 #include "esp_mn_speech_commands.h"
 #include "esp_process_sdkconfig.h"
+#if CONFIG_SR_MN_G2P_CACHE
+#include "nvs_flash.h"
+#endif
 
 TEST_CASE("multinet create/destroy API & memory leak", "[mn]")
 {
@@ -385,6 +388,183 @@ TEST_CASE("multinet add duplicated commands", "[mn]")
 }
 
 
+TEST_CASE("multinet command registry lookups", "[mn]")
+{
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    srmodel_list_t *models = esp_srmodel_init("model");
+    char *model_name = esp_srmodel_filter(models, ESP_MN_PREFIX, NULL);
+    esp_mn_iface_t *multinet = esp_mn_handle_from_name(model_name);
+
+    model_iface_data_t *model_data = multinet->create(model_name, 6000);
+    esp_mn_commands_update_from_sdkconfig(multinet, model_data);
+
+    // every phrase is found by its string and index, and removing one shifts the phrase ids
+    struct timeval tv_start, tv_end;
+    gettimeofday(&tv_start, NULL);
+    int num = 0;
+    bool consistent = true;
+    esp_mn_phrase_t *phrase = NULL;
+    while ((phrase = esp_mn_commands_get_from_index(num)) != NULL) {
+        consistent &= esp_mn_commands_get_from_string(phrase->string) == phrase;
+        num++;
+    }
+    gettimeofday(&tv_end, NULL);
+    printf("%d phrases looked up in %ld us\n", num,
+           (long)((tv_end.tv_sec - tv_start.tv_sec) * 1000000 + tv_end.tv_usec - tv_start.tv_usec));
+
+    if (num >= 2) {
+        esp_mn_phrase_t *second = esp_mn_commands_get_from_index(1);
+        esp_mn_commands_remove(esp_mn_commands_get_from_index(0)->string);
+        consistent &= esp_mn_commands_get_from_index(0) == second;
+        consistent &= esp_mn_commands_get_from_index(num - 1) == NULL;
+    }
+
+    esp_mn_commands_free();
+    multinet->destroy(model_data);
+    esp_srmodel_deinit(models);
+    TEST_ASSERT_EQUAL(true, num > 0 && consistent);
+}
+
+
+TEST_CASE("multinet batch command update", "[mn]")
+{
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    srmodel_list_t *models = esp_srmodel_init("model");
+    char *model_name = esp_srmodel_filter(models, ESP_MN_PREFIX, NULL);
+    esp_mn_iface_t *multinet = esp_mn_handle_from_name(model_name);
+
+    model_iface_data_t *model_data = multinet->create(model_name, 6000);
+    esp_mn_commands_update_from_sdkconfig(multinet, model_data);
+
+    // stage the sdkconfig commands again, replacing the current ones in one update
+    int num = esp_mn_commands_num();
+    struct timeval tv_start, tv_end;
+    gettimeofday(&tv_start, NULL);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_begin(ESP_MN_BATCH_REPLACE));
+    for (int i = 0; i < num; i++) {
+        esp_mn_phrase_t *phrase = esp_mn_commands_get_from_index(i);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_add(phrase->command_id, phrase->string, phrase->phonemes));
+    }
+    esp_mn_error_t *error = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_commit(&error));
+    gettimeofday(&tv_end, NULL);
+    printf("%d commands committed in %ld ms\n", num,
+           (long)((tv_end.tv_sec - tv_start.tv_sec) * 1000 + (tv_end.tv_usec - tv_start.tv_usec) / 1000));
+    TEST_ASSERT_EQUAL(num, esp_mn_commands_num());
+    size_t used = 0, reserved = 0, reclaimable = 0;
+    esp_mn_commands_mem_info(&used, &reserved, &reclaimable);
+    printf("commands hold %u of %u bytes\n", (unsigned)used, (unsigned)reserved);
+    TEST_ASSERT_TRUE(used > 0 && used <= reserved);
+    TEST_ASSERT_EQUAL(0, reclaimable);
+
+    // a removed command is reclaimable until the next update moves the live ones
+    size_t live = used;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_remove(esp_mn_commands_get_from_index(0)->string));
+    esp_mn_commands_mem_info(&used, NULL, &reclaimable);
+    TEST_ASSERT_EQUAL(live, used);
+    TEST_ASSERT_TRUE(reclaimable > 0);
+    size_t removed = reclaimable;
+    esp_mn_commands_update();
+    esp_mn_commands_mem_info(&used, NULL, &reclaimable);
+    TEST_ASSERT_EQUAL(0, reclaimable);
+    TEST_ASSERT_EQUAL(live - removed, used);
+    TEST_ASSERT_EQUAL(num - 1, esp_mn_commands_num());
+
+    // an invalid command drops the whole batch
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_begin(ESP_MN_BATCH_REPLACE));
+    esp_mn_commands_batch_add(1, "", NULL);
+    esp_mn_commands_batch_add(2, "!!!", "!!!");
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_mn_commands_batch_commit(NULL));
+    TEST_ASSERT_EQUAL(num - 1, esp_mn_commands_num());
+
+    // with ESP_MN_BATCH_SKIP_INVALID only the invalid command is left out,
+    // the strings are copied because the replaced list frees its own
+    char first[ESP_MN_MAX_PHRASE_LEN + 1], second[ESP_MN_MAX_PHRASE_LEN + 1];
+    strlcpy(first, esp_mn_commands_get_from_index(0)->string, sizeof(first));
+    strlcpy(second, esp_mn_commands_get_from_index(1)->string, sizeof(second));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_begin(ESP_MN_BATCH_REPLACE | ESP_MN_BATCH_SKIP_INVALID));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_add(1, first, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_add(2, "!!!", "!!!"));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_add(3, second, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_batch_commit(NULL));
+    TEST_ASSERT_EQUAL(2, esp_mn_commands_num());
+    TEST_ASSERT_NOT_NULL(esp_mn_commands_get_from_string(first));
+    TEST_ASSERT_NOT_NULL(esp_mn_commands_get_from_string(second));
+    TEST_ASSERT_NULL(esp_mn_commands_get_from_string("!!!"));
+
+    esp_mn_commands_free();
+    esp_mn_commands_mem_info(&used, &reserved, NULL);
+    TEST_ASSERT_EQUAL(0, reserved);
+    multinet->destroy(model_data);
+    esp_srmodel_deinit(models);
+}
+
+
+#if CONFIG_SR_MN_G2P_CACHE
+TEST_CASE("multinet g2p cache", "[mn]")
+{
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_init());
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_g2p_cache_clear());
+    srmodel_list_t *models = esp_srmodel_init("model");
+    char *model_name = esp_srmodel_filter(models, ESP_MN_PREFIX, NULL);
+    esp_mn_iface_t *multinet = esp_mn_handle_from_name(model_name);
+    model_iface_data_t *model_data = multinet->create(model_name, 6000);
+
+    // the second load of the same command reads its phonemes back from NVS
+    uint32_t hits = 0, misses = 0;
+    for (int i = 0; i < 2; i++) {
+        esp_mn_commands_alloc(multinet, model_data);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_add(1, "turn on the light"));
+        esp_mn_g2p_cache_stats(&hits, &misses);
+        printf("g2p cache: %lu hits, %lu misses\n", (unsigned long)hits, (unsigned long)misses);
+        TEST_ASSERT_EQUAL(i, hits);
+        TEST_ASSERT_EQUAL(1, misses);
+        esp_mn_commands_free();
+    }
+
+    // entries written by another G2P version are erased on the next lookup
+    nvs_handle_t nvs;
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open("mn_g2p", NVS_READWRITE, &nvs));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_str(nvs, "version", "flite_g2p 0"));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_blob(nvs, "stale", "x", 2));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(nvs));
+    esp_mn_commands_alloc(multinet, model_data);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_add(1, "turn on the light"));
+    esp_mn_g2p_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(2, misses);
+    size_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, nvs_get_blob(nvs, "stale", NULL, &size));
+    esp_mn_commands_free();
+
+    // a full cache evicts the entry stored first, not the one NVS happens to list first
+    esp_mn_commands_alloc(multinet, model_data);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_add(2, "turn off the light"));
+    esp_mn_commands_free();
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_set_u32(nvs, "count", CONFIG_SR_MN_G2P_CACHE_MAX_ENTRIES));
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_commit(nvs));
+    esp_mn_commands_alloc(multinet, model_data);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_add(3, "open the door"));
+    esp_mn_commands_free();
+    esp_mn_g2p_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(4, misses);
+    esp_mn_commands_alloc(multinet, model_data);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_add(2, "turn off the light"));
+    esp_mn_g2p_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(4, misses);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mn_commands_add(1, "turn on the light"));
+    esp_mn_g2p_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(5, misses);
+    nvs_close(nvs);
+    esp_mn_commands_free();
+
+    multinet->destroy(model_data);
+    esp_srmodel_deinit(models);
+    esp_mn_g2p_cache_clear();
+}
+#endif
+
+
 TEST_CASE("multinet print active commands", "[mn]")
 {
     vTaskDelay(500 / portTICK_PERIOD_MS);
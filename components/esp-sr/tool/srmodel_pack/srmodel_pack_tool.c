@@ -0,0 +1,253 @@
+/*
+ * srmodel_pack: inspect model packs (srmodels.bin) on the host with the same reader the
+ * firmware uses.
+ *
+ *   srmodel_pack list <pack>                 print the model table
+ *   srmodel_pack verify <pack>               check the header and every file checksum
+ *   srmodel_pack extract <pack> <dir>        write <dir>/<model>/<file>
+ *   srmodel_pack bench <pack> [iterations]   time header parsing and checksum verification
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#define make_dir(path) _mkdir(path)
+#else
+#define make_dir(path) mkdir(path, 0755)
+#endif
+#include "srmodel_pack.h"
+
+typedef struct {
+    char *data;
+    uint32_t size;
+    srmodel_pack_t pack;
+} pack_file_t;
+
+static int load_pack(const char *path, pack_file_t *pf)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size < 0 || (unsigned long)size > UINT32_MAX) {
+        fprintf(stderr, "%s: unsupported size\n", path);
+        fclose(fp);
+        return -1;
+    }
+    pf->size = (uint32_t)size;
+    pf->data = (char *)malloc(size ? size : 1);
+    if (pf->data == NULL || fread(pf->data, 1, size, fp) != (size_t)size) {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(fp);
+        free(pf->data);
+        return -1;
+    }
+    fclose(fp);
+
+    int err = srmodel_pack_open(&pf->pack, pf->data, pf->size, pf->size);
+    if (err != SRMODEL_PACK_OK) {
+        fprintf(stderr, "%s: %s\n", path, srmodel_pack_strerror(err));
+        free(pf->data);
+        return -1;
+    }
+    return 0;
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Number of files whose data does not match the stored CRC, 0 for v1 packs
+static int check_crcs(const pack_file_t *pf, int verbose)
+{
+    const char *p = pf->pack.table + 4;
+    uint32_t index = 0;
+    int bad = 0;
+    for (uint32_t i = 0; i < pf->pack.model_num; i++) {
+        srmodel_pack_model_t model;
+        p = srmodel_pack_model(p, &model);
+        for (uint32_t j = 0; j < model.file_num; j++, index++) {
+            srmodel_pack_file_t file;
+            p = srmodel_pack_file(p, &file);
+            if (pf->pack.crcs == NULL) {
+                continue;
+            }
+            uint32_t crc = srmodel_pack_crc32(0, pf->data + file.start, file.len);
+            if (crc != srmodel_pack_file_crc(&pf->pack, index)) {
+                if (verbose) {
+                    printf("  %.32s/%.32s: crc %08lx, expected %08lx\n", model.name, file.name, (unsigned long)crc,
+                           (unsigned long)srmodel_pack_file_crc(&pf->pack, index));
+                }
+                bad++;
+            }
+        }
+    }
+    return bad;
+}
+
+static int cmd_list(const pack_file_t *pf)
+{
+    printf("version %lu, %lu models, %lu files, header %lu bytes, pack %lu bytes\n",
+           (unsigned long)pf->pack.version, (unsigned long)pf->pack.model_num, (unsigned long)pf->pack.file_num,
+           (unsigned long)pf->pack.header_len, (unsigned long)pf->size);
+
+    const char *p = pf->pack.table + 4;
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < pf->pack.model_num; i++) {
+        srmodel_pack_model_t model;
+        p = srmodel_pack_model(p, &model);
+        printf("%.32s\n", model.name);
+        for (uint32_t j = 0; j < model.file_num; j++, index++) {
+            srmodel_pack_file_t file;
+            p = srmodel_pack_file(p, &file);
+            printf("  %-32.32s %10lu %10lu", file.name, (unsigned long)file.start, (unsigned long)file.len);
+            if (pf->pack.crcs) {
+                printf("  %08lx", (unsigned long)srmodel_pack_file_crc(&pf->pack, index));
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}
+
+static int cmd_verify(const pack_file_t *pf)
+{
+    if (pf->pack.crcs == NULL) {
+        printf("version 1 pack: header ok, no file checksums\n");
+        return 0;
+    }
+    int bad = check_crcs(pf, 1);
+    printf("%lu files, %d checksum mismatch(es)\n", (unsigned long)pf->pack.file_num, bad);
+    return bad ? 1 : 0;
+}
+
+// Names come from the pack, refuse anything that would leave the output directory
+static int safe_name(const char *name)
+{
+    size_t len = strnlen(name, SRMODEL_PACK_NAME_LEN);
+    if (len == 0 || memchr(name, '/', len) || memchr(name, '\\', len)) {
+        return 0;
+    }
+    return !(name[0] == '.' && (len == 1 || (len == 2 && name[1] == '.')));
+}
+
+static int cmd_extract(const pack_file_t *pf, const char *dir)
+{
+    char path[512];
+    make_dir(dir);
+
+    const char *p = pf->pack.table + 4;
+    for (uint32_t i = 0; i < pf->pack.model_num; i++) {
+        srmodel_pack_model_t model;
+        p = srmodel_pack_model(p, &model);
+        if (!safe_name(model.name)) {
+            fprintf(stderr, "invalid model name %.32s\n", model.name);
+            return 1;
+        }
+        snprintf(path, sizeof(path), "%s/%.32s", dir, model.name);
+        make_dir(path);
+        for (uint32_t j = 0; j < model.file_num; j++) {
+            srmodel_pack_file_t file;
+            p = srmodel_pack_file(p, &file);
+            if (!safe_name(file.name)) {
+                fprintf(stderr, "invalid file name %.32s\n", file.name);
+                return 1;
+            }
+            snprintf(path, sizeof(path), "%s/%.32s/%.32s", dir, model.name, file.name);
+            FILE *fp = fopen(path, "wb");
+            if (fp == NULL || fwrite(pf->data + file.start, 1, file.len, fp) != file.len) {
+                fprintf(stderr, "%s: write failed\n", path);
+                if (fp) {
+                    fclose(fp);
+                }
+                return 1;
+            }
+            fclose(fp);
+        }
+    }
+    printf("extracted %lu files to %s\n", (unsigned long)pf->pack.file_num, dir);
+    return 0;
+}
+
+static int cmd_bench(const pack_file_t *pf, int iterations)
+{
+    // header validation plus one walk over every record, i.e. what the loader does at boot
+    volatile uint32_t sink = 0;
+    double t0 = now_us();
+    for (int it = 0; it < iterations; it++) {
+        srmodel_pack_t pack;
+        srmodel_pack_open(&pack, pf->data, pf->size, pf->size);
+        const char *p = pack.table + 4;
+        for (uint32_t i = 0; i < pack.model_num; i++) {
+            srmodel_pack_model_t model;
+            p = srmodel_pack_model(p, &model);
+            for (uint32_t j = 0; j < model.file_num; j++) {
+                srmodel_pack_file_t file;
+                p = srmodel_pack_file(p, &file);
+                sink += file.start;
+            }
+        }
+    }
+    double parse_us = (now_us() - t0) / iterations;
+
+    t0 = now_us();
+    int bad = check_crcs(pf, 0);
+    double crc_us = now_us() - t0;
+
+    printf("header parse: %.2f us (%d iterations, %lu models, %lu files)\n", parse_us, iterations,
+           (unsigned long)pf->pack.model_num, (unsigned long)pf->pack.file_num);
+    if (pf->pack.crcs) {
+        printf("checksum verify: %.1f ms, %.1f MB/s, %d mismatch(es)\n", crc_us / 1000,
+               crc_us > 0 ? pf->size / crc_us : 0.0, bad);
+    }
+    (void)sink;
+    return 0;
+}
+
+static int usage(void)
+{
+    fprintf(stderr, "usage: srmodel_pack list|verify <pack>\n"
+                    "       srmodel_pack extract <pack> <dir>\n"
+                    "       srmodel_pack bench <pack> [iterations]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        return usage();
+    }
+    const char *cmd = argv[1];
+
+    pack_file_t pf;
+    if (load_pack(argv[2], &pf) != 0) {
+        return 1;
+    }
+
+    int ret;
+    if (strcmp(cmd, "list") == 0) {
+        ret = cmd_list(&pf);
+    } else if (strcmp(cmd, "verify") == 0) {
+        ret = cmd_verify(&pf);
+    } else if (strcmp(cmd, "extract") == 0 && argc >= 4) {
+        ret = cmd_extract(&pf, argv[3]);
+    } else if (strcmp(cmd, "bench") == 0) {
+        int iterations = argc >= 4 ? atoi(argv[3]) : 1000;
+        ret = cmd_bench(&pf, iterations > 0 ? iterations : 1);
+    } else {
+        ret = usage();
+    }
+    free(pf.data);
+    return ret;
+}
@@ -0,0 +1,51 @@
+# ctest script: PYTHON, PACK_MODEL, TOOL, VERSION and WORK_DIR are passed with -D
+file(REMOVE_RECURSE ${WORK_DIR})
+set(models ${WORK_DIR}/models)
+
+# two models, binary content including bytes >= 0x80, and a file larger than one 4 KB chunk
+string(REPEAT "0123456789abcdef" 600 big)
+file(WRITE ${models}/wn9_hijason/_MODEL_INFO_ "# comment\nwakeNet9_v1h24_Hi,Jason_3_0.63_0.635\n")
+file(WRITE ${models}/wn9_hijason/wn9_data "${big}")
+file(WRITE ${models}/wn9_hijason/wn9_index "index")
+file(WRITE ${models}/vadnet1_medium/_MODEL_INFO_ "vadnet1_medium\n")
+execute_process(COMMAND ${PYTHON} -c "import sys; open(sys.argv[1],'wb').write(bytes(range(256))*3)"
+                ${models}/vadnet1_medium/vadn1_data)
+
+function(run)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE rc OUTPUT_VARIABLE out ERROR_VARIABLE err)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "${ARGN} failed (${rc}):\n${out}${err}")
+    endif()
+    message(STATUS "${out}")
+endfunction()
+
+run(${PYTHON} ${PACK_MODEL} -m ${models} -o pack.bin -v ${VERSION})
+set(pack ${models}/pack.bin)
+run(${TOOL} list ${pack})
+run(${TOOL} verify ${pack})
+run(${TOOL} bench ${pack} 100)
+run(${TOOL} extract ${pack} ${WORK_DIR}/out)
+
+file(GLOB_RECURSE originals RELATIVE ${models} ${models}/*/*)
+list(LENGTH originals count)
+if(NOT count EQUAL 5)
+    message(FATAL_ERROR "expected 5 model files, found ${count}")
+endif()
+foreach(f ${originals})
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${models}/${f} ${WORK_DIR}/out/${f} RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "${f} differs after extraction")
+    endif()
+endforeach()
+
+# a flipped data byte must fail verification of a v2 pack
+if(VERSION EQUAL 2)
+    # CMake cannot write arbitrary bytes, flip the last one with python
+    execute_process(COMMAND ${PYTHON} -c
+        "import sys; d=bytearray(open(sys.argv[1],'rb').read()); d[-1]^=1; open(sys.argv[2],'wb').write(d)"
+        ${pack} ${WORK_DIR}/corrupt.bin)
+    execute_process(COMMAND ${TOOL} verify ${WORK_DIR}/corrupt.bin RESULT_VARIABLE rc OUTPUT_QUIET)
+    if(rc EQUAL 0)
+        message(FATAL_ERROR "corrupted pack passed verification")
+    endif()
+endif()
@@ -0,0 +1,173 @@
+// Unit tests of the pack reader against packs built in memory
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "srmodel_pack.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                      \
+        }                                                                    \
+    } while (0)
+
+typedef struct {
+    const char *model;
+    const char *name;
+    const char *data;
+    uint32_t len;
+} test_file_t;
+
+// Same layout as model/pack_model.py: files of a model are contiguous, data follows the header
+static const test_file_t test_files[] = {
+    {"wn9_hijason", "_MODEL_INFO_", "wakeNet9_v1h24_Hi,Jason_3_0.63_0.635", 36},
+    {"wn9_hijason", "wn9_data", "\x80\x81\xff\x00\x01", 5},
+    {"vadnet1_medium", "_MODEL_INFO_", "vadnet1_medium", 14},
+    {"0123456789abcdef0123456789abcdef", "vadn1_data", "data", 4},
+};
+#define TEST_FILE_NUM (sizeof(test_files) / sizeof(test_files[0]))
+#define TEST_MODEL_NUM 3
+
+static char *build_pack(int version, uint32_t *size)
+{
+    uint32_t header_len = 4 + TEST_MODEL_NUM * SRMODEL_PACK_MODEL_LEN + TEST_FILE_NUM * SRMODEL_PACK_FILE_LEN;
+    uint32_t prefix = 0;
+    if (version >= 2) {
+        prefix = SRMODEL_PACK_PREFIX_LEN;
+        header_len += prefix + TEST_FILE_NUM * 4;
+    }
+    uint32_t total = header_len;
+    for (size_t i = 0; i < TEST_FILE_NUM; i++) {
+        total += test_files[i].len;
+    }
+
+    char *buf = (char *)calloc(1, total);
+    char *p = buf + prefix;
+    char *crc = buf + header_len - TEST_FILE_NUM * 4;
+    char *data = buf + header_len;
+    srmodel_pack_put_u32(p, TEST_MODEL_NUM);
+    p += 4;
+    for (size_t i = 0; i < TEST_FILE_NUM; i++) {
+        if (i == 0 || strcmp(test_files[i].model, test_files[i - 1].model) != 0) {
+            uint32_t n = 0;
+            for (size_t j = i; j < TEST_FILE_NUM && strcmp(test_files[j].model, test_files[i].model) == 0; j++) {
+                n++;
+            }
+            memcpy(p, test_files[i].model, strlen(test_files[i].model));
+            srmodel_pack_put_u32(p + SRMODEL_PACK_NAME_LEN, n);
+            p += SRMODEL_PACK_MODEL_LEN;
+        }
+        memcpy(p, test_files[i].name, strlen(test_files[i].name));
+        srmodel_pack_put_u32(p + SRMODEL_PACK_NAME_LEN, data - buf);
+        srmodel_pack_put_u32(p + SRMODEL_PACK_NAME_LEN + 4, test_files[i].len);
+        p += SRMODEL_PACK_FILE_LEN;
+        memcpy(data, test_files[i].data, test_files[i].len);
+        if (version >= 2) {
+            srmodel_pack_put_u32(crc, srmodel_pack_crc32(0, data, test_files[i].len));
+            crc += 4;
+        }
+        data += test_files[i].len;
+    }
+    if (version >= 2) {
+        srmodel_pack_put_u32(buf, SRMODEL_PACK_MAGIC);
+        srmodel_pack_put_u32(buf + 4, version);
+        srmodel_pack_put_u32(buf + 8, header_len);
+        srmodel_pack_put_u32(buf + 12, srmodel_pack_crc32(0, buf + prefix, header_len - prefix));
+    }
+    *size = total;
+    return buf;
+}
+
+static void test_crc32(void)
+{
+    CHECK(srmodel_pack_crc32(0, "123456789", 9) == 0xCBF43926);
+    // chained over two halves
+    CHECK(srmodel_pack_crc32(srmodel_pack_crc32(0, "1234", 4), "56789", 5) == 0xCBF43926);
+    CHECK(srmodel_pack_crc32(0, "", 0) == 0);
+}
+
+static void test_walk(int version)
+{
+    uint32_t size = 0;
+    char *buf = build_pack(version, &size);
+    srmodel_pack_t pack;
+    CHECK(srmodel_pack_open(&pack, buf, size, size) == SRMODEL_PACK_OK);
+    CHECK(pack.version == (uint32_t)version);
+    CHECK(pack.model_num == TEST_MODEL_NUM);
+    CHECK(pack.file_num == TEST_FILE_NUM);
+    CHECK((pack.crcs != NULL) == (version >= 2));
+    CHECK(srmodel_pack_table(buf) == pack.table);
+
+    const char *p = pack.table + 4;
+    size_t index = 0;
+    for (uint32_t i = 0; i < pack.model_num; i++) {
+        srmodel_pack_model_t model;
+        p = srmodel_pack_model(p, &model);
+        CHECK(strncmp(model.name, test_files[index].model, SRMODEL_PACK_NAME_LEN) == 0);
+        for (uint32_t j = 0; j < model.file_num; j++, index++) {
+            srmodel_pack_file_t file;
+            p = srmodel_pack_file(p, &file);
+            CHECK(strncmp(file.name, test_files[index].name, SRMODEL_PACK_NAME_LEN) == 0);
+            CHECK(file.len == test_files[index].len);
+            CHECK(file.start >= pack.header_len && file.start + file.len <= size);
+            CHECK(memcmp(buf + file.start, test_files[index].data, file.len) == 0);
+            if (version >= 2) {
+                CHECK(srmodel_pack_file_crc(&pack, index) == srmodel_pack_crc32(0, buf + file.start, file.len));
+            }
+        }
+    }
+    CHECK(index == TEST_FILE_NUM);
+    CHECK(p == buf + pack.header_len - (version >= 2 ? TEST_FILE_NUM * 4 : 0));
+    free(buf);
+}
+
+static void test_corruption(void)
+{
+    uint32_t size = 0;
+    char *buf = build_pack(2, &size);
+    uint32_t header_len = srmodel_pack_u32(buf + 8);
+    srmodel_pack_t pack;
+
+    // header cut short, in the prefix and in the table
+    CHECK(srmodel_pack_open(&pack, buf, 3, size) == SRMODEL_PACK_ERR_TRUNCATED);
+    CHECK(srmodel_pack_open(&pack, buf, 12, size) == SRMODEL_PACK_ERR_TRUNCATED);
+    CHECK(srmodel_pack_open(&pack, buf, header_len - 1, size) == SRMODEL_PACK_ERR_TRUNCATED);
+
+    // a flipped table byte breaks the header CRC
+    buf[SRMODEL_PACK_PREFIX_LEN + 5] ^= 1;
+    CHECK(srmodel_pack_open(&pack, buf, size, size) == SRMODEL_PACK_ERR_HEADER_CRC);
+    buf[SRMODEL_PACK_PREFIX_LEN + 5] ^= 1;
+
+    // file data past the end of the partition
+    CHECK(srmodel_pack_open(&pack, buf, size, size - 1) == SRMODEL_PACK_ERR_RANGE);
+
+    srmodel_pack_put_u32(buf + 4, 3);
+    CHECK(srmodel_pack_open(&pack, buf, size, size) == SRMODEL_PACK_ERR_VERSION);
+    free(buf);
+
+    // v1 packs have no header CRC, only the bounds protect the loader
+    buf = build_pack(1, &size);
+    srmodel_pack_put_u32(buf, 0x10000);
+    CHECK(srmodel_pack_open(&pack, buf, size, size) == SRMODEL_PACK_ERR_TRUNCATED);
+    srmodel_pack_put_u32(buf, TEST_MODEL_NUM);
+    srmodel_pack_put_u32(buf + 4 + SRMODEL_PACK_MODEL_LEN + SRMODEL_PACK_NAME_LEN, 0xFFFFFFF0);
+    CHECK(srmodel_pack_open(&pack, buf, size, size) == SRMODEL_PACK_ERR_RANGE);
+    free(buf);
+}
+
+int main(void)
+{
+    test_crc32();
+    test_walk(1);
+    test_walk(2);
+    test_corruption();
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all pack reader tests passed\n");
+    return 0;
+}
@@ -3,12 +3,17 @@
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
 #include "esp_chip_info.h"
 #include "esp_flash.h"
 #include "esp_system.h" 
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include "mic_i2s.h"
 #include "speaker_i2s.h"
 #include "wakeword.h"
+#include "wakeword_profiler.h"
+#include "wakeword_threshold.h"
 #include "Mymqtt_client.h"
 #include "wifi.h" 
 #include "esp_log.h"  
@@ -22,8 +27,113 @@
 #define TAG "MAIN"  
  
 static esp_mqtt_client_handle_t mqtt_client = NULL; 
+
+// Set by the wakeword verifier when a speculatively started upload turns out to be a false trigger
+static volatile bool upload_cancelled = false;
  
 
+// Set once Wi-Fi is up and the MQTT client exists; wake events before that are recorded and held back
+#define NET_READY_BIT BIT0
+static EventGroupHandle_t net_events = NULL;
+
+// Only one early wake event is buffered, later ones are dropped until it has been uploaded
+static volatile bool early_upload_pending = false;
+
+static bool network_ready(void)
+{
+    return (xEventGroupGetBits(net_events) & NET_READY_BIT) != 0;
+}
+
+static void publish_meta(const char *device_id, int total_out_bytes)
+{
+    uint8_t meta[4];
+    meta[0] = (total_out_bytes) & 0xFF;
+    meta[1] = (total_out_bytes >> 8) & 0xFF;
+    meta[2] = (total_out_bytes >> 16) & 0xFF;
+    meta[3] = (total_out_bytes >> 24) & 0xFF;
+    char meta_topic[64];
+    snprintf(meta_topic, sizeof(meta_topic), "esp32/audio/%s/meta", device_id);
+    if (mqtt_publish_audio(mqtt_client, meta_topic, (const char*)meta, sizeof(meta)) != 0) {
+        ESP_LOGW(TAG, "Failed to publish meta; continuing anyway");
+    } else {
+        ESP_LOGI(TAG, "Published meta total_out_bytes=%d", total_out_bytes);
+    }
+}
+
+// Fill buf with up to bytes_to_read bytes of PCM16, returns the number of bytes read
+static int read_audio_chunk(uint8_t *buf, int bytes_to_read)
+{
+    int bytes_read = 0;
+    int attempts = 0;
+
+    // fill chunk by repeatedly calling loop_read_and_resample()
+    while (bytes_read < bytes_to_read && attempts < 50) {
+        int r = i2s_mic_read(buf + bytes_read, bytes_to_read - bytes_read);
+        if (r < 0) {
+            ESP_LOGE(TAG, "loop_read_and_resample error %d", r);
+            break;
+        } else if (r == 0) {
+            // no data available right now
+            vTaskDelay(pdMS_TO_TICKS(5));
+            attempts++;
+            continue;
+        }
+        bytes_read += r;
+    }
+    return bytes_read;
+}
+
+// Wake word heard before the network came up: record the whole utterance into PSRAM now and
+// publish it once MQTT is available, so the first command after a power cut is not lost
+static void send_buffered_audio(const char *device_id, int total_out_bytes, int chunk_bytes)
+{
+    uint8_t *audio = heap_caps_malloc(total_out_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!audio) {
+        audio = malloc(total_out_bytes);
+    }
+    if (!audio) {
+        ESP_LOGE(TAG, "early wake buffer allocation failed (%d bytes)", total_out_bytes);
+        return;
+    }
+
+    int recorded = 0;
+    while (recorded < total_out_bytes && !upload_cancelled) {
+        int want = total_out_bytes - recorded;
+        if (want > chunk_bytes) {
+            want = chunk_bytes;
+        }
+        int got = read_audio_chunk(audio + recorded, want);
+        if (got <= 0) {
+            ESP_LOGW(TAG, "No bytes read while buffering, stopping at %d bytes", recorded);
+            break;
+        }
+        recorded += got;
+    }
+    ESP_LOGI(TAG, "Buffered %d bytes of early wake audio, waiting for network", recorded);
+
+    EventBits_t bits = xEventGroupWaitBits(net_events, NET_READY_BIT, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(EARLY_WAKE_UPLOAD_TIMEOUT_MS));
+    if (!(bits & NET_READY_BIT)) {
+        ESP_LOGW(TAG, "Network not up after %d ms, dropping early wake audio", EARLY_WAKE_UPLOAD_TIMEOUT_MS);
+    } else if (upload_cancelled) {
+        // the verifier rejected the detection, nothing reached the backend yet
+        ESP_LOGI(TAG, "Early wake event cancelled before upload");
+    } else if (recorded > 0) {
+        char data_topic[64];
+        snprintf(data_topic, sizeof(data_topic), "esp32/audio/%s", device_id);
+        publish_meta(device_id, recorded);
+        for (int off = 0; off < recorded; off += chunk_bytes) {
+            int len = (recorded - off) < chunk_bytes ? (recorded - off) : chunk_bytes;
+            if (mqtt_publish_audio(mqtt_client, data_topic, (const char*)audio + off, len) != 0) {
+                ESP_LOGE(TAG, "Failed publish buffered chunk at %d", off);
+            }
+            vTaskDelay(pdMS_TO_TICKS(5));
+        }
+        ESP_LOGI(TAG, "Early wake audio uploaded: %d bytes", recorded);
+    }
+    free(audio);
+}
+
 void send_audio_to_server(void* param)
 {
     const int record_time_sec = 5;
@@ -39,6 +149,15 @@ void send_audio_to_server(void* param)
     const int CHUNK_SAMPLES = MQTT_CHUNK_SIZE / bytes_per_sample_out;
     const int out_chunk_bytes_max = CHUNK_SAMPLES * bytes_per_sample_out;
 
+    const char *device_id = "testDevice";
+
+    if (!network_ready()) {
+        send_buffered_audio(device_id, total_out_bytes, out_chunk_bytes_max);
+        early_upload_pending = false;
+        vTaskDelete(NULL);
+        return;
+    }
+
     // publish buffer (PCM16)
     uint8_t *publish_buf = malloc(out_chunk_bytes_max);
     if (!publish_buf) {
@@ -48,48 +167,23 @@ void send_audio_to_server(void* param)
     }
 
     // publish meta
-    uint8_t meta[4];
-    meta[0] = (total_out_bytes) & 0xFF;
-    meta[1] = (total_out_bytes >> 8) & 0xFF;
-    meta[2] = (total_out_bytes >> 16) & 0xFF;
-    meta[3] = (total_out_bytes >> 24) & 0xFF;
-    char meta_topic[64];
-    const char *device_id = "testDevice";
-    snprintf(meta_topic, sizeof(meta_topic), "esp32/audio/%s/meta", device_id);
-    if (mqtt_publish_audio(mqtt_client, meta_topic, (const char*)meta, sizeof(meta)) != 0) {
-        ESP_LOGW(TAG, "Failed to publish meta; continuing anyway");
-    } else {
-        ESP_LOGI(TAG, "Published meta total_out_bytes=%d", total_out_bytes);
-    }
+    publish_meta(device_id, total_out_bytes);
  
     // streaming loop
     int samples_sent = 0;
     while (samples_sent < total_samples) {
+        if (upload_cancelled) {
+            ESP_LOGI(TAG, "Upload cancelled after %d samples", samples_sent);
+            break;
+        }
+
         // how many samples we want in this chunk
         int samples_to_request = CHUNK_SAMPLES;
         if ((total_samples - samples_sent) < samples_to_request) {
             samples_to_request = (total_samples - samples_sent);
         }
 
-        int bytes_to_read = samples_to_request * bytes_per_sample_out;
-        int bytes_read = 0;
-        int attempts = 0;
-
-        // fill chunk by repeatedly calling loop_read_and_resample()
-        while (bytes_read < bytes_to_read && attempts < 50) {
-            int r = i2s_mic_read(publish_buf + bytes_read, bytes_to_read - bytes_read);
-            if (r < 0) {
-                ESP_LOGE(TAG, "loop_read_and_resample error %d", r);
-                break;
-            } else if (r == 0) {
-                // no data available right now
-                vTaskDelay(pdMS_TO_TICKS(5));
-                attempts++;
-                continue;
-            }
-            bytes_read += r;
-        }
-
+        int bytes_read = read_audio_chunk(publish_buf, samples_to_request * bytes_per_sample_out);
         if (bytes_read <= 0) {
             ESP_LOGW(TAG, "No bytes read for this chunk, aborting");
             break;
@@ -122,9 +216,83 @@ void send_audio_to_server(void* param)
 
 static void wakeword_detected_callback() {
     ESP_LOGI(TAG, "Wake word callback triggered");
+    if (!network_ready()) {
+        if (early_upload_pending) {
+            ESP_LOGW(TAG, "Network still down and an early wake event is already buffered, ignoring");
+            return;
+        }
+        early_upload_pending = true;
+    }
+    upload_cancelled = false;
     xTaskCreate(&send_audio_to_server, "send_audio_to_server", 8192, NULL, 5, NULL);
 } 
 
+// Verification failed: stop the upload and tell the backend to discard what it already has
+static void wakeword_cancel_callback() {
+    ESP_LOGI(TAG, "Wake word cancelled");
+    upload_cancelled = true;
+
+    char cancel_topic[64];
+    snprintf(cancel_topic, sizeof(cancel_topic), "esp32/audio/%s/cancel", "testDevice");
+    if (network_ready()) {
+        mqtt_publish_audio(mqtt_client, cancel_topic, "1", 1);
+    }
+}
+
+// Runs on the second core while Wi-Fi associates on the first: load/map the models, create
+// WakeNet and start listening, so the wake word is heard before the network is up
+static void wakeword_init_task(void *param)
+{
+    int64_t t0 = esp_timer_get_time();
+    wakeword_init(wakeword_detected_callback);  //, NULL // Init WakeNet
+    wakeword_set_cancel_callback(wakeword_cancel_callback);
+    ESP_LOGI(TAG, "Wakeword ready after %lld ms", (long long)((esp_timer_get_time() - t0) / 1000));
+
+    xTaskCreatePinnedToCore(&wakeword_task, "wakeword_task", 8192, NULL, 5, NULL, WAKEWORD_CORE);
+    vTaskDelete(NULL);
+}
+
+// Periodically publish wakeword pipeline timing so regressions show up on the backend
+static void publish_wakeword_stats_task(void *param)
+{
+    char *json = malloc(WAKEWORD_STATS_JSON_SIZE);
+    if (!json) {
+        ESP_LOGE(TAG, "stats buffer allocation failed");
+        vTaskDelete(NULL);
+        return;
+    }
+
+    char stats_topic[64];
+    char threshold_topic[64];
+    snprintf(stats_topic, sizeof(stats_topic), "esp32/stats/%s/wakeword", "testDevice");
+    snprintf(threshold_topic, sizeof(threshold_topic), "esp32/stats/%s/threshold", "testDevice");
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(WAKEWORD_STATS_INTERVAL_MS));
+
+        ww_profiler_snapshot_t snap;
+        wakeword_profiler_snapshot(&snap);
+        int len = wakeword_profiler_to_json(&snap, json, WAKEWORD_STATS_JSON_SIZE);
+        if (len < 0) {
+            ESP_LOGW(TAG, "stats JSON truncated, increase WAKEWORD_STATS_JSON_SIZE");
+            continue;
+        }
+        ESP_LOGI(TAG, "wakeword frames=%lu missed=%lu detect max=%lu us",
+                 (unsigned long)snap.frames, (unsigned long)snap.missed_deadlines,
+                 (unsigned long)snap.stage[WW_STAGE_DETECT].max_us);
+        if (mqtt_client) {
+            mqtt_publish_audio(mqtt_client, stats_topic, json, len);
+        }
+
+        ww_operating_point_t op;
+        wakeword_threshold_get(&op);
+        len = wakeword_threshold_to_json(&op, json, WAKEWORD_STATS_JSON_SIZE);
+        if (len > 0 && mqtt_client) {
+            mqtt_publish_audio(mqtt_client, threshold_topic, json, len);
+        }
+    }
+}
+
 void mqtt_message_handler(const char *topic, const char *data, int len) {
     ESP_LOGI("MQTT_CB", "Received topic: %s", topic);
     ESP_LOGI("MQTT_CB", "Payload: %.*s", len, data);
@@ -134,27 +302,37 @@ void app_main(void)
 { 
     ESP_LOGI(TAG, "Starting application");
 
-    // Initialize Wi-Fi 
-    wifi_init_sta();
-
-    // Initialize MQTT client 
-    mqtt_client = mqtt_init_client(mqtt_url, mqtt_message_handler);
-
-    if (!mqtt_client) {
-        ESP_LOGE(TAG, "MQTT client init failed");
-    }
+    net_events = xEventGroupCreate();
 
+    // Start Wi-Fi without waiting for it, this also initializes NVS which the model loader needs
+    wifi_start_sta();
 
     // Initialize I2S microphone 
     ESP_LOGI(TAG, "Starting audio recording...");
+#if WAKEWORD_LOW_POWER
+    i2s_mic_init_batched(WAKEWORD_FRAME_SAMPLES, WAKEWORD_LP_BATCH_FRAMES);
+#else
     i2s_mic_init();
+#endif
+
+    // Initialize wake-word detection on the other core while Wi-Fi associates
+    xTaskCreatePinnedToCore(&wakeword_init_task, "ww_init", 8192, NULL, 5, NULL, WAKEWORD_CORE);
+
     i2s_speaker_init(); 
     i2s_speaker_play_sine_wave();
-     
-    // Initialize wake-word detection
-    wakeword_init(wakeword_detected_callback);  //, NULL // Init WakeNet
 
-    xTaskCreate(&wakeword_task, "wakeword_task", 8192, NULL, 5, NULL);
+    // Initialize MQTT client once Wi-Fi is connected
+    ESP_LOGI(TAG, "Waiting for Wi-Fi connection...");
+    wifi_wait_connected(portMAX_DELAY);
+    mqtt_client = mqtt_init_client(mqtt_url, mqtt_message_handler);
+
+    if (!mqtt_client) {
+        ESP_LOGE(TAG, "MQTT client init failed");
+    } else {
+        xEventGroupSetBits(net_events, NET_READY_BIT);
+    }
+
+    xTaskCreate(&publish_wakeword_stats_task, "ww_stats", 4096, NULL, 2, NULL);
 
     // Initialize OTA
     // ota_init();
@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "wakeword.h"
+#include "wakeword_threshold.h"
+#include "mic_filter.h"
+
+static const char *TAG = "WW_BENCH";
+
+// Corpus layout:
+//   <corpus>/positive/*.wav   each file contains the wake word (once)
+//   <corpus>/negative/*.wav   background audio, every detection is a false alarm
+// All files must be 16 kHz, mono, 16-bit PCM.
+#define BENCH_DEFAULT_CORPUS  "corpus"
+#define BENCH_DEFAULT_MODELS  "model"
+#define BENCH_PATH_MAX        512
+
+typedef struct {
+    int files;
+    int files_detected;       // files with at least one detection
+    int detections;
+    uint64_t samples;
+    uint64_t frames;
+    uint64_t gated;           // frames silenced by the noise gate
+} bench_set_t;
+
+typedef struct {
+    uint32_t *v;
+    size_t n;
+    size_t cap;
+} latency_list_t;
+
+static int frame_detections = 0;
+static latency_list_t latencies;
+static uint64_t total_proc_us = 0;
+
+static void bench_wake_cb(void)
+{
+    frame_detections++;
+}
+
+// A speculative detection that failed verification would have had its upload aborted
+static void bench_cancel_cb(void)
+{
+    frame_detections--;
+}
+
+static void latency_push(uint32_t us)
+{
+    if (latencies.n == latencies.cap) {
+        size_t cap = latencies.cap ? latencies.cap * 2 : 4096;
+        uint32_t *v = realloc(latencies.v, cap * sizeof(uint32_t));
+        if (!v) {
+            return;
+        }
+        latencies.v = v;
+        latencies.cap = cap;
+    }
+    latencies.v[latencies.n++] = us;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t *sorted, size_t n, int pct)
+{
+    if (n == 0) {
+        return 0;
+    }
+    size_t idx = (n * pct + 99) / 100;
+    return sorted[idx ? idx - 1 : 0];
+}
+
+static uint32_t read_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_le16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+// Position fp at the start of the PCM data and return its size in bytes, or -1 if unsupported
+static long wav_open_data(FILE *fp, const char *path)
+{
+    uint8_t hdr[12];
+    if (fread(hdr, 1, sizeof(hdr), fp) != sizeof(hdr) || memcmp(hdr, "RIFF", 4) || memcmp(hdr + 8, "WAVE", 4)) {
+        ESP_LOGW(TAG, "%s: not a RIFF/WAVE file", path);
+        return -1;
+    }
+
+    int fmt_ok = 0;
+    uint8_t chunk[8];
+    while (fread(chunk, 1, sizeof(chunk), fp) == sizeof(chunk)) {
+        uint32_t size = read_le32(chunk + 4);
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[16];
+            if (size < sizeof(fmt) || fread(fmt, 1, sizeof(fmt), fp) != sizeof(fmt)) {
+                break;
+            }
+            uint16_t format = read_le16(fmt);
+            uint16_t channels = read_le16(fmt + 2);
+            uint32_t rate = read_le32(fmt + 4);
+            uint16_t bits = read_le16(fmt + 14);
+            if (format != 1 || channels != 1 || rate != WAKEWORD_SAMPLE_RATE || bits != 16) {
+                ESP_LOGW(TAG, "%s: need PCM16 mono %d Hz (got fmt=%d ch=%d rate=%lu bits=%d)",
+                         path, WAKEWORD_SAMPLE_RATE, format, channels, (unsigned long)rate, bits);
+                return -1;
+            }
+            fmt_ok = 1;
+            fseek(fp, (long)(size - sizeof(fmt) + (size & 1)), SEEK_CUR);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            return fmt_ok ? (long)size : -1;
+        } else {
+            fseek(fp, (long)(size + (size & 1)), SEEK_CUR);
+        }
+    }
+    ESP_LOGW(TAG, "%s: no PCM data chunk", path);
+    return -1;
+}
+
+// Stream one file frame by frame through the mic filter and the same per-frame path as wakeword_task
+static int bench_file(const char *path, int16_t *frame, bench_set_t *set)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        ESP_LOGW(TAG, "cannot open %s", path);
+        return -1;
+    }
+    long data_bytes = wav_open_data(fp, path);
+    if (data_bytes < 0) {
+        fclose(fp);
+        return -1;
+    }
+
+    wakeword_reset();
+    mic_filter_init(MIC_FILTER_HPF_CUTOFF_HZ, WAKEWORD_SAMPLE_RATE);
+    frame_detections = 0;
+    i2s_mic_stats_t stats = {0};
+
+    long remaining = data_bytes / (long)sizeof(int16_t);
+    while (remaining > 0) {
+        size_t want = remaining < WAKEWORD_FRAME_SAMPLES ? (size_t)remaining : WAKEWORD_FRAME_SAMPLES;
+        size_t got = fread(frame, sizeof(int16_t), want, fp);
+        if (got == 0) {
+            break;
+        }
+        // zero-pad the tail so the last partial frame is still scored
+        if (got < WAKEWORD_FRAME_SAMPLES) {
+            memset(frame + got, 0, (WAKEWORD_FRAME_SAMPLES - got) * sizeof(int16_t));
+        }
+        remaining -= got;
+        set->samples += got;
+
+        int64_t t0 = esp_timer_get_time();
+        int kept = mic_filter_process(frame, WAKEWORD_FRAME_SAMPLES, &stats);
+#if WAKEWORD_ADAPTIVE_THRESHOLD
+        wakeword_threshold_update(stats.rms_dbfs);
+#endif
+        set->frames++;
+        if (kept > 0) {
+            wakeword_process_frame(frame);
+        } else {
+            wakeword_process_gated();
+            set->gated++;
+        }
+        uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+        total_proc_us += us;
+        latency_push(us);
+    }
+    // flush an open verification window with gated silence so a late verdict is still counted
+    for (int i = 0; i < WAKEWORD_VERIFY_FRAMES; i++) {
+        wakeword_process_gated();
+    }
+    fclose(fp);
+
+    set->files++;
+    set->detections += frame_detections;
+    if (frame_detections > 0) {
+        set->files_detected++;
+    }
+    ESP_LOGD(TAG, "%s: %d detection(s)", path, frame_detections);
+    return 0;
+}
+
+static void bench_dir(const char *corpus, const char *label, int16_t *frame, bench_set_t *set)
+{
+    char dir_path[BENCH_PATH_MAX];
+    snprintf(dir_path, sizeof(dir_path), "%s/%s", corpus, label);
+
+    DIR *dir = opendir(dir_path);
+    if (!dir) {
+        ESP_LOGW(TAG, "no %s directory", dir_path);
+        return;
+    }
+
+    struct dirent *ent;
+    char file_path[BENCH_PATH_MAX];
+    while ((ent = readdir(dir)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (len < 4 || strcasecmp(ent->d_name + len - 4, ".wav") != 0) {
+            continue;
+        }
+        snprintf(file_path, sizeof(file_path), "%s/%s", dir_path, ent->d_name);
+        bench_file(file_path, frame, set);
+    }
+    closedir(dir);
+}
+
+static const char *env_or(const char *name, const char *fallback)
+{
+    const char *v = getenv(name);
+    return (v && v[0]) ? v : fallback;
+}
+
+void app_main(void)
+{
+    const char *corpus = env_or("WW_BENCH_CORPUS", BENCH_DEFAULT_CORPUS);
+    const char *models = env_or("WW_BENCH_MODELS", BENCH_DEFAULT_MODELS);
+    det_mode_t det_mode = (det_mode_t)atoi(env_or("WW_BENCH_DET_MODE", "1"));
+
+    if (wakeword_init_ex(models, det_mode, bench_wake_cb) != 0) {
+        ESP_LOGE(TAG, "wakeword init failed (models: %s)", models);
+        return;
+    }
+    wakeword_set_cancel_callback(bench_cancel_cb);
+
+    int16_t *frame = malloc(WAKEWORD_FRAME_SAMPLES * sizeof(int16_t));
+    if (!frame) {
+        ESP_LOGE(TAG, "frame allocation failed");
+        wakeword_deinit();
+        return;
+    }
+
+    bench_set_t pos = {0}, neg = {0};
+    bench_dir(corpus, "positive", frame, &pos);
+    bench_dir(corpus, "negative", frame, &neg);
+
+    double pos_sec = (double)pos.samples / WAKEWORD_SAMPLE_RATE;
+    double neg_sec = (double)neg.samples / WAKEWORD_SAMPLE_RATE;
+    double audio_sec = pos_sec + neg_sec;
+
+    double frr = pos.files ? 100.0 * (pos.files - pos.files_detected) / pos.files : 0.0;
+    double fa_per_hour = neg_sec > 0 ? neg.detections * 3600.0 / neg_sec : 0.0;
+    double rtf = audio_sec > 0 ? (total_proc_us / 1e6) / audio_sec : 0.0;
+
+    qsort(latencies.v, latencies.n, sizeof(uint32_t), cmp_u32);
+
+    printf("corpus: %s  det_mode: %d\n", corpus, det_mode);
+    printf("positive: %d files, %.1f s, missed %d -> FRR %.2f %%\n",
+           pos.files, pos_sec, pos.files - pos.files_detected, frr);
+    printf("negative: %d files, %.2f h, %d false alarms -> FA %.3f /h\n",
+           neg.files, neg_sec / 3600.0, neg.detections, fa_per_hour);
+    printf("gated frames: positive %.1f %%, negative %.1f %%\n",
+           pos.frames ? 100.0 * pos.gated / pos.frames : 0.0,
+           neg.frames ? 100.0 * neg.gated / neg.frames : 0.0);
+    printf("real-time factor: %.4f (%.1f s processing for %.1f s audio)\n",
+           rtf, total_proc_us / 1e6, audio_sec);
+    printf("frame latency us (%u frames): p50 %lu  p90 %lu  p99 %lu  max %lu\n",
+           (unsigned)latencies.n,
+           (unsigned long)percentile(latencies.v, latencies.n, 50),
+           (unsigned long)percentile(latencies.v, latencies.n, 90),
+           (unsigned long)percentile(latencies.v, latencies.n, 99),
+           (unsigned long)(latencies.n ? latencies.v[latencies.n - 1] : 0));
+
+    free(latencies.v);
+    free(frame);
+    wakeword_deinit();
+}